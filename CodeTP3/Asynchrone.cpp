@@ -0,0 +1,73 @@
+/**
+ * \file Asynchrone.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe ExecuteurFond
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#include "Asynchrone.h"
+
+namespace TP3 {
+    /**
+     * \brief Constructeur
+     * \param[in] nbThreads le nombre de threads du bassin
+     * \post Les threads attendent des coroutines a reprendre
+     */
+    ExecuteurFond::ExecuteurFond(std::size_t nbThreads) : arret(false) {
+        if (nbThreads == 0) {
+            nbThreads = 1;
+        }
+        for (std::size_t i = 0; i < nbThreads; i++) {
+            threads.emplace_back(&ExecuteurFond::_executer, this);
+        }
+    }
+
+    /**
+     *  \brief Destructeur
+     *  \post La file est videe et les threads sont termines
+     */
+    ExecuteurFond::~ExecuteurFond() {
+        {
+            std::lock_guard<std::mutex> verrou(verrouFile);
+            arret = true;
+        }
+        disponible.notify_all();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * \brief Met une coroutine en file
+     * \param[in] p_coroutine la coroutine suspendue a reprendre
+     */
+    void ExecuteurFond::planifie(std::coroutine_handle<> p_coroutine) {
+        {
+            std::lock_guard<std::mutex> verrou(verrouFile);
+            file.push_back(p_coroutine);
+        }
+        disponible.notify_one();
+    }
+
+    /**
+     * \brief Reprend les coroutines de la file jusqu'a l'arret
+     */
+    void ExecuteurFond::_executer() {
+        while (true) {
+            std::coroutine_handle<> coroutine;
+            {
+                std::unique_lock<std::mutex> verrou(verrouFile);
+                disponible.wait(verrou, [this] { return arret || !file.empty(); });
+                if (file.empty()) {
+                    return;
+                }
+                coroutine = file.front();
+                file.pop_front();
+            }
+            coroutine.resume();
+        }
+    }
+
+}//Fin du namespace
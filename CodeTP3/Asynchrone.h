@@ -0,0 +1,213 @@
+/**
+ * \file Asynchrone.h
+ * \brief Ce fichier contient les outils de l'interface asynchrone (coroutines C++20) du dictionnaire.
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#ifndef ASYNCHRONE_H_
+#define ASYNCHRONE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace TP3 {
+
+//classe représentant le résultat d'une coroutine du dictionnaire
+//La coroutine démarre dès l'appel. Si elle se termine sans suspendre (recherche exacte), co_await
+//retourne immédiatement. Sinon, l'appelant est repris sur le thread qui termine la coroutine.
+//Une tâche détruite avant la fin de sa coroutine est abandonnée sans bloquer: l'arrêt de la coroutine est demandé
+//(voir jetonArret) et elle libère elle-même son état lorsqu'elle se termine.
+    template<typename T>
+    class Tache {
+    public:
+
+        // Classe interne représentant l'état partagé entre la coroutine et la tâche
+        class promise_type {
+        public:
+            std::optional<T> valeur;                    // Le résultat, une fois la coroutine terminée
+            std::exception_ptr exception;               // L'exception levée par la coroutine, s'il y a lieu
+            std::atomic<void *> continuation{nullptr};  // L'appelant suspendu, &abandon si la tâche a été
+                                                        // détruite avant la fin, ou this une fois terminée
+            std::stop_source arret;                     // Arrêt demandé lorsque la tâche est abandonnée
+            bool termine = false;                       // Pour attend() et le destructeur
+            std::mutex verrouFin;                       // La notification se fait sous verrou: le thread qui
+            std::condition_variable fin;                // attend peut détruire la coroutine dès son réveil
+
+            Tache get_return_object() {
+                return Tache(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_never initial_suspend() noexcept { return {}; }
+
+            // Adresse qui marque une tâche abandonnée dans continuation
+            static inline char abandon = 0;
+
+            // Reprend l'appelant suspendu, s'il y en a un
+            struct FinCoroutine {
+                bool await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> p_coroutine) noexcept {
+                    promise_type &promesse = p_coroutine.promise();
+                    void *appelant = promesse.continuation.exchange(&promesse);
+                    //Personne n'attendra plus le résultat: la coroutine libère son état
+                    if (appelant == &abandon) {
+                        p_coroutine.destroy();
+                        return std::noop_coroutine();
+                    }
+                    {
+                        std::lock_guard<std::mutex> verrou(promesse.verrouFin);
+                        promesse.termine = true;
+                        promesse.fin.notify_all();
+                    }
+                    if (appelant != nullptr) {
+                        return std::coroutine_handle<>::from_address(appelant);
+                    }
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            FinCoroutine final_suspend() noexcept { return {}; }
+
+            template<typename U>
+            void return_value(U &&p_valeur) { valeur.emplace(std::forward<U>(p_valeur)); }
+
+            void unhandled_exception() { exception = std::current_exception(); }
+        };
+
+        Tache(Tache &&autre) noexcept : coroutine(std::exchange(autre.coroutine, nullptr)) {}
+        Tache(const Tache &) = delete;
+        Tache &operator=(const Tache &) = delete;
+
+        //Destructeur. Si la coroutine est terminée, libère son état; sinon, demande son arrêt et l'abandonne.
+        ~Tache() {
+            if (coroutine) {
+                promise_type &promesse = coroutine.promise();
+                promesse.arret.request_stop();
+                void *attendu = nullptr;
+                if (promesse.continuation.compare_exchange_strong(attendu, &promise_type::abandon)) {
+                    return;
+                }
+                //La coroutine est terminée: on attend seulement qu'elle ait fini de notifier
+                _attendreFin();
+                coroutine.destroy();
+            }
+        }
+
+        //Indique si la coroutine est terminée
+        bool estTerminee() const {
+            std::lock_guard<std::mutex> verrou(coroutine.promise().verrouFin);
+            return coroutine.promise().termine;
+        }
+
+        //Bloquer le thread courant jusqu'à la fin de la coroutine et retourner son résultat
+        //Relance l'exception de la coroutine, s'il y a lieu
+        T attend() {
+            _attendreFin();
+            return _resultat();
+        }
+
+        // Permet co_await sur une tâche
+        bool await_ready() const noexcept { return estTerminee(); }
+
+        bool await_suspend(std::coroutine_handle<> p_appelant) noexcept {
+            void *attendu = nullptr;
+            //Si la coroutine s'est terminée entre-temps, l'appelant continue sans suspendre
+            return coroutine.promise().continuation.compare_exchange_strong(attendu, p_appelant.address());
+        }
+
+        T await_resume() { return _resultat(); }
+
+        // Classe interne: dans la coroutine, co_await Tache<T>::jetonArret() retourne le jeton dont l'arrêt
+        // est demandé lorsque la tâche est abandonnée. La coroutine n'est pas suspendue.
+        class JetonArret {
+        public:
+            std::stop_token jeton;
+
+            bool await_ready() const noexcept { return false; }
+            bool await_suspend(std::coroutine_handle<promise_type> p_coroutine) noexcept {
+                jeton = p_coroutine.promise().arret.get_token();
+                return false;
+            }
+            std::stop_token await_resume() noexcept { return std::move(jeton); }
+        };
+
+        static JetonArret jetonArret() { return JetonArret(); }
+
+    private:
+
+        std::coroutine_handle<promise_type> coroutine;
+
+        explicit Tache(std::coroutine_handle<promise_type> p_coroutine) : coroutine(p_coroutine) {}
+
+        void _attendreFin() {
+            promise_type &promesse = coroutine.promise();
+            std::unique_lock<std::mutex> verrou(promesse.verrouFin);
+            promesse.fin.wait(verrou, [&promesse] { return promesse.termine; });
+        }
+
+        T _resultat() {
+            if (coroutine.promise().exception) {
+                std::rethrow_exception(coroutine.promise().exception);
+            }
+            return std::move(*coroutine.promise().valeur);
+        }
+    };
+
+//classe représentant un bassin de threads qui exécute les parties coûteuses des coroutines
+    class ExecuteurFond {
+    public:
+
+        //Constructeur. Lance nbThreads threads (au moins un).
+        explicit ExecuteurFond(std::size_t nbThreads = std::thread::hardware_concurrency());
+
+        //Destructeur. Les coroutines encore en file sont reprises avant l'arrêt des threads.
+        ~ExecuteurFond();
+
+        ExecuteurFond(const ExecuteurFond &) = delete;
+        ExecuteurFond &operator=(const ExecuteurFond &) = delete;
+
+        //Mettre une coroutine suspendue en file pour qu'un thread du bassin la reprenne
+        void planifie(std::coroutine_handle<> p_coroutine);
+
+        // Classe interne: co_await executeur.transfere() suspend la coroutine et la remet
+        // à la fin de la file. Sert à passer sur un thread du bassin, puis à céder sa place
+        // aux autres tâches pendant un long parcours.
+        class Transfert {
+        public:
+            ExecuteurFond &executeur;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> p_coroutine) { executeur.planifie(p_coroutine); }
+            void await_resume() const noexcept {}
+        };
+
+        Transfert transfere() { return Transfert{*this}; }
+
+    private:
+
+        std::deque<std::coroutine_handle<>> file;   // Les coroutines prêtes à être reprises
+        std::mutex verrouFile;
+        std::condition_variable disponible;
+        bool arret;
+        std::vector<std::thread> threads;
+
+        //Fonction de chaque thread du bassin
+        void _executer();
+    };
+}
+
+#endif /* ASYNCHRONE_H_ */
@@ -0,0 +1,141 @@
+/**
+ * \file BancAllocations.cpp
+ * \brief Compte les allocations de mémoire faites par les opérations du dictionnaire
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : BancAllocations fichierDictionnaire
+ * Chaque appel à operator new est compté. Les recherches par vue (appartient, traduit) ne devraient rien allouer,
+ * et un ajout par déplacement seulement le noeud et le vecteur de traductions.
+ * Un fichier temporaire BancAllocations.tmp est créé dans le répertoire courant pour mesurer recharge.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include "Dictionnaire.h"
+
+using namespace std;
+using namespace TP3;
+
+//Nombre d'appels à operator new depuis le début du programme
+static unsigned long nbAllocations = 0;
+
+void *operator new(size_t taille)
+{
+	nbAllocations++;
+	if (void *p = malloc(taille == 0 ? 1 : taille))
+		return p;
+	throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	free(p);
+}
+
+//Affiche un nombre d'allocations, en tout et par opération
+static void rapporte(const string &nom, unsigned long allocations, unsigned long nbOperations)
+{
+	cout << nom << " : " << allocations << " allocations pour " << nbOperations << " operations ("
+		 << static_cast<double>(allocations) / nbOperations << " par operation)" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		cerr << "Utilisation : " << argv[0] << " fichierDictionnaire" << endl;
+		return 1;
+	}
+
+	try
+	{
+		ifstream englishFrench(argv[1]);
+		if (!englishFrench)
+		{
+			cerr << "Fichier '" << argv[1] << "' introuvable!" << endl;
+			return 1;
+		}
+		unsigned long avant = nbAllocations;
+		Dictionnaire dictEnFr(englishFrench);
+		englishFrench.close();
+		unsigned long allocations = nbAllocations - avant;
+		rapporte("Construction", allocations, dictEnFr.profil().nbNoeuds);
+
+		//Les mots de la phrase sont des vues sur la phrase: aucune chaîne temporaire
+		const string phrase = "the cat abacus aardvark zzzz aback abacuses";
+		string_view vue(phrase);
+		const unsigned long nbTours = 1000;
+		unsigned long nbRecherches = 0, controle = 0;
+		avant = nbAllocations;
+		for (unsigned long tour = 0; tour < nbTours; tour++)
+		{
+			for (size_t debut = 0; debut < vue.size();)
+			{
+				size_t fin = vue.find(' ', debut);
+				if (fin == string_view::npos)
+					fin = vue.size();
+				string_view mot = vue.substr(debut, fin - debut);
+				if (dictEnFr.appartient(mot))
+					controle += dictEnFr.traduit(mot).size();
+				nbRecherches++;
+				debut = fin + 1;
+			}
+		}
+		rapporte("appartient + traduit", nbAllocations - avant, nbRecherches);
+
+		string motNouveau = "motsansequivalentaucun", traductionNouvelle = "une traduction assez longue pour le tas";
+		avant = nbAllocations;
+		dictEnFr.ajouteMot(move(motNouveau), move(traductionNouvelle));
+		rapporte("ajouteMot par deplacement, mot nouveau", nbAllocations - avant, 1);
+
+		avant = nbAllocations;
+		dictEnFr.ajouteMotEnPlace("motsansequivalentaucun", 40, 'x');
+		rapporte("ajouteMotEnPlace, mot existant", nbAllocations - avant, 1);
+
+		//Nouvelle version du fichier: un mot sur dix retiré, mille mots nouveaux ajoutés
+		const char *cheminTemporaire = "BancAllocations.tmp";
+		unsigned long nbLignes = 0;
+		{
+			ifstream original(argv[1]);
+			ofstream modifie(cheminTemporaire);
+			string ligne;
+			while (getline(original, ligne))
+			{
+				if (++nbLignes % 10 != 0)
+					modifie << ligne << '\n';
+			}
+			for (int i = 0; i < 1000; i++)
+				modifie << "motnouveaudurechargement" << i << "\tune traduction assez longue pour le tas\n";
+		}
+		ifstream fichierModifie(cheminTemporaire);
+		avant = nbAllocations;
+		Dictionnaire::StatistiquesRechargement stats = dictEnFr.recharge(fichierModifie);
+		fichierModifie.close();
+		remove(cheminTemporaire);
+		rapporte("recharge (lecture comprise)", nbAllocations - avant, nbLignes);
+		cout << "  " << stats.motsAjoutes << " mots ajoutes, " << stats.motsSupprimes << " supprimes, "
+			 << stats.traductionsAjoutees << " traductions ajoutees, " << stats.traductionsSupprimees
+			 << " retirees, " << stats.dureeMs << " ms" << endl;
+
+		cout << "(controle " << controle << ")" << endl;
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * \file BancOperationsEnBloc.cpp
+ * \brief Compare les opérations en bloc exécutées par un seul thread et en parallèle
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : BancOperationsEnBloc [nbMots] [nbMotsAutre] [nbThreads]
+ * Deux dictionnaires de mots au hasard sont construits (le second partage la moitié de ses mots avec le premier),
+ * puis fusionne, retranche et intersecte sont mesurés sur une copie du premier, avec 1 thread puis avec nbThreads
+ * (par défaut le nombre de coeurs). Les résultats des deux exécutions doivent être identiques.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Dictionnaire.h"
+
+using namespace std;
+using namespace TP3;
+
+//Retourne un mot de 12 lettres au hasard
+static string motAuHasard(mt19937 &generateur)
+{
+	string mot(12, 'a');
+	for (char &c : mot)
+	{
+		c = static_cast<char>('a' + generateur() % 26);
+	}
+	return mot;
+}
+
+//Applique une opération en bloc à une copie de base et retourne sa durée en millisecondes
+static double mesure(const Dictionnaire &base, const Dictionnaire &autre, int operation, unsigned int nbThreads,
+					 size_t &nbMotsResultat)
+{
+	Dictionnaire copie;
+	copie.fusionne(base);
+	copie.configureParallelisme(nbThreads);
+	chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+	switch (operation)
+	{
+		case 0:
+			copie.fusionne(autre);
+			break;
+		case 1:
+			copie.retranche(autre);
+			break;
+		default:
+			copie.intersecte(autre);
+			break;
+	}
+	double duree = chrono::duration<double, milli>(chrono::steady_clock::now() - debut).count();
+	nbMotsResultat = copie.profil().nbNoeuds;
+	return duree;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t nbMots = argc > 1 ? strtoul(argv[1], 0, 10) : 1000000;
+	size_t nbMotsAutre = argc > 2 ? strtoul(argv[2], 0, 10) : 100000;
+	unsigned int nbThreads = argc > 3 ? strtoul(argv[3], 0, 10) : thread::hardware_concurrency();
+	if (nbThreads == 0) nbThreads = 1;
+
+	try
+	{
+		mt19937 generateur(2022);
+		Dictionnaire base, autre;
+		vector<string> mots;
+		for (size_t i = 0; i < nbMots; i++)
+		{
+			mots.push_back(motAuHasard(generateur));
+			base.ajouteMot(mots.back(), "t");
+		}
+		for (size_t i = 0; i < nbMotsAutre; i++)
+		{
+			if (i % 2 == 0 && !mots.empty())
+				autre.ajouteMot(mots[generateur() % mots.size()], "u");
+			else
+				autre.ajouteMot(motAuHasard(generateur), "u");
+		}
+
+		cout << base.profil().nbNoeuds << " mots, " << autre.profil().nbNoeuds << " dans l'autre dictionnaire, "
+			 << thread::hardware_concurrency() << " coeurs" << endl;
+		const char *noms[] = {"fusionne", "retranche", "intersecte"};
+		for (int operation = 0; operation < 3; operation++)
+		{
+			size_t motsSequentiel, motsParallele;
+			double sequentiel = mesure(base, autre, operation, 1, motsSequentiel);
+			double parallele = mesure(base, autre, operation, nbThreads, motsParallele);
+			cout << noms[operation] << " : 1 thread " << sequentiel << " ms, " << nbThreads << " threads "
+				 << parallele << " ms (acceleration " << sequentiel / parallele << "), " << motsParallele << " mots"
+				 << endl;
+			if (motsSequentiel != motsParallele)
+			{
+				cerr << "Les deux executions ne donnent pas le meme nombre de mots (" << motsSequentiel << ")" << endl;
+				return 1;
+			}
+		}
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
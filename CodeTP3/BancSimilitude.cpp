@@ -0,0 +1,149 @@
+/**
+ * \file BancSimilitude.cpp
+ * \brief Mesure le débit de similitude sur des mots ASCII, comparé à l'ancien calcul octet par octet
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : BancSimilitude fichierDictionnaire [nbPaires]
+ * Les paires sont formées des mots anglais du dictionnaire écrits en ASCII. La similitude du dictionnaire, qui
+ * prend le chemin rapide sur ces mots, est mesurée contre l'ancien calcul par la table complète des distances, qui
+ * allouait une ligne par caractère à chaque appel. Les deux doivent donner la même somme de contrôle.
+ * suggereCorrections est aussi mesuré, sur des mots du dictionnaire dont une lettre a été remplacée.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Dictionnaire.h"
+
+using namespace std;
+using namespace TP3;
+
+//Ancienne similitude: distance de Levenshtein octet par octet, par la table complète
+static double similitudeOctets(string_view a, string_view b)
+{
+	vector<vector<unsigned int>> d(a.size() + 1, vector<unsigned int>(b.size() + 1));
+	for (unsigned int i = 1; i <= a.size(); i++)
+		d[i][0] = i;
+	for (unsigned int j = 1; j <= b.size(); j++)
+		d[0][j] = j;
+	for (unsigned int i = 1; i <= a.size(); i++)
+	{
+		for (unsigned int j = 1; j <= b.size(); j++)
+		{
+			d[i][j] = min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1)});
+		}
+	}
+	double longueur = max(a.size(), b.size());
+	return longueur == 0 ? 1.0 : (longueur - d[a.size()][b.size()]) / longueur;
+}
+
+//Retourne le meilleur de cinq tours d'une mesure, en nanosecondes par appel
+template <typename Mesure>
+static double meilleurDeCinq(size_t nbAppels, Mesure mesure)
+{
+	double meilleur = 0.0;
+	for (int tour = 0; tour < 5; tour++)
+	{
+		chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+		mesure();
+		double duree = chrono::duration<double, nano>(chrono::steady_clock::now() - debut).count() / nbAppels;
+		meilleur = tour == 0 ? duree : min(meilleur, duree);
+	}
+	return meilleur;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		cerr << "Utilisation : " << argv[0] << " fichierDictionnaire [nbPaires]" << endl;
+		return 1;
+	}
+	size_t nbPaires = argc > 2 ? strtoul(argv[2], 0, 10) : 200000;
+
+	try
+	{
+		ifstream englishFrench(argv[1]);
+		if (!englishFrench)
+		{
+			cerr << "Fichier '" << argv[1] << "' introuvable!" << endl;
+			return 1;
+		}
+		Dictionnaire dictEnFr(englishFrench);
+		englishFrench.close();
+
+		//Seuls les mots ASCII sont gardés: l'ancien calcul compterait un caractère accentué comme deux
+		vector<string> mots = dictEnFr.page(0, dictEnFr.profil().nbNoeuds);
+		mots.erase(remove_if(mots.begin(), mots.end(), [](const string &mot)
+		{
+			return any_of(mot.begin(), mot.end(), [](char c) { return static_cast<unsigned char>(c) >= 0x80; });
+		}), mots.end());
+		if (mots.empty())
+		{
+			cerr << "Le dictionnaire ne contient aucun mot ASCII." << endl;
+			return 1;
+		}
+		mt19937 generateur(2022);
+		vector<pair<size_t, size_t>> paires(nbPaires);
+		for (pair<size_t, size_t> &paire : paires)
+		{
+			paire = make_pair(generateur() % mots.size(), generateur() % mots.size());
+		}
+
+		double sommeDictionnaire = 0.0, sommeOctets = 0.0;
+		double nsDictionnaire = meilleurDeCinq(paires.size(), [&]()
+		{
+			sommeDictionnaire = 0.0;
+			for (const pair<size_t, size_t> &paire : paires)
+				sommeDictionnaire += dictEnFr.similitude(mots[paire.first], mots[paire.second]);
+		});
+		double nsOctets = meilleurDeCinq(paires.size(), [&]()
+		{
+			sommeOctets = 0.0;
+			for (const pair<size_t, size_t> &paire : paires)
+				sommeOctets += similitudeOctets(mots[paire.first], mots[paire.second]);
+		});
+
+		vector<string> fautes;
+		for (int i = 0; i < 300; i++)
+		{
+			string mot = mots[generateur() % mots.size()];
+			if (mot.size() > 1)
+				mot[generateur() % mot.size()] = 'x';
+			fautes.push_back(mot);
+		}
+		size_t nbSuggestions = 0;
+		double nsSuggestions = meilleurDeCinq(fautes.size(), [&]()
+		{
+			for (const string &mot : fautes)
+				nbSuggestions += dictEnFr.suggereCorrections(mot).size();
+		});
+
+		cout << mots.size() << " mots, " << paires.size() << " paires" << endl;
+		cout << "similitude          : " << nsDictionnaire << " ns/appel (controle " << sommeDictionnaire << ")" << endl;
+		cout << "octet par octet     : " << nsOctets << " ns/appel (controle " << sommeOctets << ")" << endl;
+		cout << "suggereCorrections  : " << nsSuggestions / 1e6 << " ms/requete (" << nbSuggestions << " suggestions)"
+			 << endl;
+		if (fabs(sommeDictionnaire - sommeOctets) > 1e-6)
+		{
+			cerr << "Les deux calculs ne donnent pas la meme somme de controle" << endl;
+			return 1;
+		}
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
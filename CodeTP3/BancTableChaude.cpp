@@ -0,0 +1,124 @@
+/**
+ * \file BancTableChaude.cpp
+ * \brief Mesure les recherches avec et sans la table des mots chauds, sur une charge qui suit la loi de Zipf
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : BancTableChaude fichierDictionnaire [nbMotsChauds] [nbRecherches]
+ * Le i-ème mot le plus fréquent (dans un ordre aléatoire fixe) est cherché avec une probabilité proportionnelle à 1/i.
+ * La première moitié de la charge entraîne les accès, puis toute la charge est mesurée: dans l'arbre seul, avec la
+ * table chaude, puis avec la table après la suppression d'un mot sur cent (pris parmi les moins fréquents), qui ne doit pas
+ * la désactiver.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "Dictionnaire.h"
+
+using namespace std;
+using namespace TP3;
+
+//Cherche tous les mots de la charge et retourne le temps moyen par recherche, en nanosecondes
+static double mesure(const Dictionnaire &dictionnaire, const vector<string> &charge, size_t &controle)
+{
+	chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+	for (const string &mot : charge)
+	{
+		controle += dictionnaire.appartient(mot);
+	}
+	return chrono::duration<double, nano>(chrono::steady_clock::now() - debut).count() / charge.size();
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		cerr << "Utilisation : " << argv[0] << " fichierDictionnaire [nbMotsChauds] [nbRecherches]" << endl;
+		return 1;
+	}
+	size_t nbMotsChauds = argc > 2 ? strtoul(argv[2], 0, 10) : 256;
+	size_t nbRecherches = argc > 3 ? strtoul(argv[3], 0, 10) : 2000000;
+
+	try
+	{
+		ifstream englishFrench(argv[1]);
+		if (!englishFrench)
+		{
+			cerr << "Fichier '" << argv[1] << "' introuvable!" << endl;
+			return 1;
+		}
+		Dictionnaire dictEnFr(englishFrench);
+		englishFrench.close();
+
+		vector<string> mots = dictEnFr.page(0, dictEnFr.profil().nbNoeuds);
+		if (mots.empty())
+		{
+			cerr << "Le dictionnaire est vide." << endl;
+			return 1;
+		}
+		mt19937 generateur(2022);
+		shuffle(mots.begin(), mots.end(), generateur);
+		vector<double> poids(mots.size());
+		for (size_t i = 0; i < poids.size(); i++)
+		{
+			poids[i] = 1.0 / (i + 1);
+		}
+		discrete_distribution<size_t> zipf(poids.begin(), poids.end());
+		vector<string> charge(nbRecherches);
+		for (string &mot : charge)
+		{
+			mot = mots[zipf(generateur)];
+		}
+
+		ostringstream entrainement;
+		for (size_t i = 0; i < charge.size() / 2; i++)
+		{
+			entrainement << charge[i] << ' ';
+		}
+		istringstream corpus(entrainement.str());
+		dictEnFr.entraineAcces(corpus);
+
+		size_t controle = 0;
+		double arbreSeul = mesure(dictEnFr, charge, controle);
+		double comparaisonsArbre = dictEnFr.profil().comparaisonsPondereesArbre;
+
+		dictEnFr.optimiseAcces(nbMotsChauds);
+		double avecTable = mesure(dictEnFr, charge, controle);
+		double comparaisonsTable = dictEnFr.profil().comparaisonsPonderees;
+		size_t chaudsAvant = dictEnFr.nbMotsChauds();
+
+		//On supprime un mot sur cent du dictionnaire, tous dans la moitié la moins fréquente: la table doit rester active
+		size_t nbSupprimes = 0;
+		for (size_t i = mots.size() / 2; i < mots.size(); i += 50)
+		{
+			dictEnFr.supprimeMot(mots[i]);
+			nbSupprimes++;
+		}
+		double apresSuppressions = mesure(dictEnFr, charge, controle);
+
+		cout << mots.size() << " mots, " << charge.size() << " recherches (Zipf), table de " << nbMotsChauds
+			 << " mots" << endl;
+		cout << "Arbre seul         : " << arbreSeul << " ns/recherche, " << comparaisonsArbre
+			 << " comparaisons ponderees" << endl;
+		cout << "Table chaude       : " << avecTable << " ns/recherche, " << comparaisonsTable
+			 << " comparaisons ponderees, " << chaudsAvant << " mots chauds" << endl;
+		cout << "Apres " << nbSupprimes << " suppressions : " << apresSuppressions << " ns/recherche, "
+			 << dictEnFr.nbMotsChauds() << " mots chauds" << endl;
+		cout << "(controle " << controle << ")" << endl;
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
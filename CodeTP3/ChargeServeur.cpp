@@ -0,0 +1,113 @@
+/**
+ * \file ChargeServeur.cpp
+ * \brief Générateur de charge pour le serveur de traduction
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : ChargeServeur fichierMots [cheminSocket] [nbClients] [requetesParClient] [profondeurPipeline]
+ * Chaque client envoie des requêtes traduit/appartient (et une suggestion sur 100) par paquets de
+ * profondeurPipeline requêtes, puis attend leurs réponses.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "ClientDictionnaire.h"
+
+using namespace std;
+using namespace TP3;
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		cerr << "Utilisation : " << argv[0]
+			 << " fichierMots [cheminSocket] [nbClients] [requetesParClient] [profondeurPipeline]" << endl;
+		return 1;
+	}
+
+	string chemin = argc > 2 ? argv[2] : Protocole::CHEMIN_DEFAUT;
+	size_t nbClients = argc > 3 ? strtoul(argv[3], 0, 10) : 8;
+	size_t requetesParClient = argc > 4 ? strtoul(argv[4], 0, 10) : 100000;
+	size_t profondeur = argc > 5 ? strtoul(argv[5], 0, 10) : 32;
+	if (nbClients == 0) nbClients = 1;
+	if (profondeur == 0) profondeur = 1;
+
+	//Les mots des requêtes sont pris dans la première colonne du fichier (format du dictionnaire ou un mot par ligne)
+	vector<string> mots;
+	ifstream fichier(argv[1]);
+	for (string ligne; getline(fichier, ligne);)
+	{
+		if (!ligne.empty() && ligne[0] != '#')
+		{
+			mots.push_back(ligne.substr(0, ligne.find_first_of('\t')));
+		}
+	}
+	if (mots.empty())
+	{
+		cerr << "Aucun mot trouve dans '" << argv[1] << "'." << endl;
+		return 1;
+	}
+
+	vector<size_t> erreurs(nbClients, 0);
+	vector<thread> clients;
+	chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+
+	for (size_t c = 0; c < nbClients; c++)
+	{
+		clients.emplace_back([&, c]()
+		{
+			try
+			{
+				ClientDictionnaire client(chemin);
+				size_t indice = c * 7919;
+				for (size_t envoyees = 0; envoyees < requetesParClient;)
+				{
+					size_t paquet = min(profondeur, requetesParClient - envoyees);
+					for (size_t i = 0; i < paquet; i++, indice++)
+					{
+						const string &mot = mots[indice % mots.size()];
+						if (indice % 100 == 0)
+							client.envoie(Protocole::SUGGERE, mot);
+						else if (indice % 2 == 0)
+							client.envoie(Protocole::TRADUIT, mot);
+						else
+							client.envoie(Protocole::APPARTIENT, mot);
+					}
+					for (size_t i = 0; i < paquet; i++)
+					{
+						if (client.recoit().statut == Protocole::ERREUR)
+							erreurs[c]++;
+					}
+					envoyees += paquet;
+				}
+			}
+			catch (exception & e)
+			{
+				cerr << "Client " << c << " : " << e.what() << endl;
+				erreurs[c] = requetesParClient;
+			}
+		});
+	}
+	for (thread & client : clients)
+	{
+		client.join();
+	}
+
+	double secondes = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+	size_t total = nbClients * requetesParClient, totalErreurs = 0;
+	for (size_t e : erreurs)
+	{
+		totalErreurs += e;
+	}
+
+	cout << total << " requetes, " << nbClients << " clients, pipeline de " << profondeur << endl;
+	cout << secondes << " s, " << total / secondes << " requetes/s, " << totalErreurs << " erreurs" << endl;
+
+	return totalErreurs == 0 ? 0 : 1;
+}
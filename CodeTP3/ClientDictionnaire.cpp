@@ -0,0 +1,180 @@
+/**
+ * \file ClientDictionnaire.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe ClientDictionnaire
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#include "ClientDictionnaire.h"
+
+#include <cerrno>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Taille du tampon de lecture du client
+#define TAILLE_TAMPON_LECTURE 65536
+
+namespace TP3 {
+    /**
+     * \brief Constructeur
+     * \param[in] chemin le chemin du socket du serveur
+     * \post Le client est connecte au serveur
+     */
+    ClientDictionnaire::ClientDictionnaire(const std::string &chemin) : fd(-1), prochainIdentifiant(0) {
+        sockaddr_un adresse = {};
+        adresse.sun_family = AF_UNIX;
+        if (chemin.size() >= sizeof(adresse.sun_path)) {
+            throw std::runtime_error("ClientDictionnaire: le chemin du socket est trop long.");
+        }
+        std::strcpy(adresse.sun_path, chemin.c_str());
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd == -1 || connect(fd, reinterpret_cast<sockaddr *>(&adresse), sizeof(adresse)) == -1) {
+            if (fd != -1) {
+                close(fd);
+            }
+            throw std::runtime_error("ClientDictionnaire: impossible de se connecter a " + chemin + ".");
+        }
+    }
+
+    /**
+     *  \brief Destructeur
+     *  \post La connexion est fermee
+     */
+    ClientDictionnaire::~ClientDictionnaire() {
+        close(fd);
+    }
+
+    /**
+     * \brief Verifie si un mot appartient au dictionnaire du serveur
+     * \param[in] mot le mot a verifier
+     * \return un bool a vrai si il s'y trouve
+     */
+    bool ClientDictionnaire::appartient(const std::string &mot) {
+        return _requeteSynchrone(Protocole::APPARTIENT, mot).statut == Protocole::OK;
+    }
+
+    /**
+     * \brief Demande les traductions d'un mot au serveur
+     * \param[in] mot le mot a traduire
+     * \return les traductions, vide si le mot n'est pas dans le dictionnaire
+     */
+    std::vector<std::string> ClientDictionnaire::traduit(const std::string &mot) {
+        return _requeteSynchrone(Protocole::TRADUIT, mot).mots;
+    }
+
+    /**
+     * \brief Demande des suggestions de correction au serveur
+     * \param[in] mot le mot mal ecrit
+     * \return au plus 5 suggestions
+     */
+    std::vector<std::string> ClientDictionnaire::suggereCorrections(const std::string &mot) {
+        return _requeteSynchrone(Protocole::SUGGERE, mot).mots;
+    }
+
+    /**
+     * \brief Met une requete en file sans l'envoyer
+     * \param[in] operation l'operation demandee
+     * \param[in] mot le mot de la requete
+     * \return l'identifiant de la requete
+     */
+    std::uint32_t ClientDictionnaire::envoie(Protocole::Operation operation, const std::string &mot) {
+        std::uint32_t identifiant = prochainIdentifiant++;
+        Protocole::ecrireU32(tamponEnvoi, identifiant);
+        tamponEnvoi.push_back(static_cast<char>(operation));
+        Protocole::ecrireMot(tamponEnvoi, mot);
+        return identifiant;
+    }
+
+    /**
+     * \brief Transmet toutes les requetes en file au serveur
+     * \post La file d'envoi est vide
+     */
+    void ClientDictionnaire::vide() {
+        std::size_t envoye = 0;
+        while (envoye < tamponEnvoi.size()) {
+            ssize_t n = send(fd, tamponEnvoi.data() + envoye, tamponEnvoi.size() - envoye, MSG_NOSIGNAL);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("vide: la connexion au serveur est perdue.");
+            }
+            envoye += n;
+        }
+        tamponEnvoi.clear();
+    }
+
+    /**
+     * \brief Attend et decode la prochaine reponse du serveur
+     * \return la reponse recue
+     */
+    ClientDictionnaire::Reponse ClientDictionnaire::recoit() {
+        if (!tamponEnvoi.empty()) {
+            vide();
+        }
+
+        char tampon[TAILLE_TAMPON_LECTURE];
+        while (true) {
+            //Essaie de decoder une reponse complete avec ce qui est deja recu
+            if (tamponReception.size() >= Protocole::TAILLE_ENTETE_REPONSE) {
+                const char *donnees = tamponReception.data();
+                std::size_t nbMots = Protocole::lireU16(donnees + 5);
+                std::size_t position = Protocole::TAILLE_ENTETE_REPONSE;
+                bool complete = true;
+                for (std::size_t i = 0; i < nbMots && complete; i++) {
+                    if (tamponReception.size() < position + 2) {
+                        complete = false;
+                    } else {
+                        position += 2 + Protocole::lireU16(donnees + position);
+                        complete = tamponReception.size() >= position;
+                    }
+                }
+
+                if (complete) {
+                    Reponse reponse;
+                    reponse.identifiant = Protocole::lireU32(donnees);
+                    reponse.statut = static_cast<Protocole::Statut>(donnees[4]);
+                    position = Protocole::TAILLE_ENTETE_REPONSE;
+                    for (std::size_t i = 0; i < nbMots; i++) {
+                        std::size_t longueur = Protocole::lireU16(donnees + position);
+                        reponse.mots.emplace_back(donnees + position + 2, longueur);
+                        position += 2 + longueur;
+                    }
+                    tamponReception.erase(0, position);
+                    return reponse;
+                }
+            }
+
+            ssize_t n = recv(fd, tampon, sizeof(tampon), 0);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("recoit: la connexion au serveur est perdue.");
+            }
+            tamponReception.append(tampon, n);
+        }
+    }
+
+    /**
+     * \brief Envoie une requete et attend sa reponse
+     * \param[in] operation l'operation demandee
+     * \param[in] mot le mot de la requete
+     * \return la reponse du serveur
+     */
+    ClientDictionnaire::Reponse ClientDictionnaire::_requeteSynchrone(Protocole::Operation operation,
+                                                                      const std::string &mot) {
+        envoie(operation, mot);
+        Reponse reponse = recoit();
+        if (reponse.statut == Protocole::ERREUR) {
+            throw std::runtime_error("ClientDictionnaire: le serveur n'a pas pu traiter la requete.");
+        }
+        return reponse;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,73 @@
+/**
+ * \file ClientDictionnaire.h
+ * \brief Ce fichier contient l'interface d'un client du serveur de traduction.
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#ifndef CLIENTDICTIONNAIRE_H_
+#define CLIENTDICTIONNAIRE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Protocole.h"
+
+namespace TP3 {
+
+//classe représentant une connexion à un ServeurDictionnaire
+    class ClientDictionnaire {
+    public:
+
+        //Réponse du serveur à une requête
+        struct Reponse {
+            std::uint32_t identifiant;          // L'identifiant retourné par envoie()
+            Protocole::Statut statut;           // Le statut de la requête
+            std::vector<std::string> mots;      // Les traductions ou les suggestions
+        };
+
+        //Constructeur. Se connecte au serveur.
+        //Exception	runtime_error si la connexion est impossible
+        explicit ClientDictionnaire(const std::string &chemin = Protocole::CHEMIN_DEFAUT);
+
+        //Destructeur. Ferme la connexion.
+        ~ClientDictionnaire();
+
+        ClientDictionnaire(const ClientDictionnaire &) = delete;
+        ClientDictionnaire &operator=(const ClientDictionnaire &) = delete;
+
+        //Les trois opérations du dictionnaire, de façon synchrone
+        //Elles ne doivent pas être utilisées pendant que des requêtes envoyées par envoie() sont en attente
+        //Exception	runtime_error si la connexion est perdue ou si le serveur retourne une erreur
+        bool appartient(const std::string &mot);
+        std::vector<std::string> traduit(const std::string &mot);
+        std::vector<std::string> suggereCorrections(const std::string &mot);
+
+        //Mettre une requête en file sans attendre sa réponse (pipelinage)
+        //On retourne l'identifiant qui permettra de retrouver sa réponse
+        std::uint32_t envoie(Protocole::Operation operation, const std::string &mot);
+
+        //Transmettre au serveur toutes les requêtes en file
+        //Exception	runtime_error si la connexion est perdue
+        void vide();
+
+        //Attendre la prochaine réponse. Les requêtes en file sont transmises au besoin.
+        //Les réponses peuvent arriver dans un ordre différent de celui des requêtes
+        //Exception	runtime_error si la connexion est perdue
+        Reponse recoit();
+
+    private:
+
+        int fd;                                 // Le socket connecté au serveur
+        std::uint32_t prochainIdentifiant;      // L'identifiant de la prochaine requête
+        std::string tamponEnvoi;                // Requêtes pas encore transmises
+        std::string tamponReception;            // Octets reçus pas encore décodés
+
+        //Fonction qui envoie une requête et attend sa réponse
+        Reponse _requeteSynchrone(Protocole::Operation operation, const std::string &mot);
+    };
+}
+
+#endif /* CLIENTDICTIONNAIRE_H_ */
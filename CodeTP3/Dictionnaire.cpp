@@ -9,69 +9,38 @@
 
 #include "Dictionnaire.h"
 
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
 // Limite du nombre de suggestions
 #define LIMITE_SUGGESTIONS 5
 
+// Nombre de noeuds examinés par suggereCorrectionsAsync avant de céder sa place
+#define TRANCHE_SUGGESTIONS 256
+
+// Nombre de mots en deçà duquel les opérations en bloc ne lancent plus de tâche parallèle
+#define SEUIL_PARALLELE 4096
+
 namespace TP3 {
     /**
      * \brief Constructeur par défaut
      * \post Une instance de la classe Dictionnaire est initialisée
      */
-    Dictionnaire::Dictionnaire() : racine(0), cpt(0) {}
+    Dictionnaire::Dictionnaire() : racine(0), cpt(0), generation(0), nbThreadsEnBloc(0), nbParcours(0), comptageAcces(false), enregistreur(0) {}
 
     /**
      * \brief Constructeur par avec un fichier
      * \param[in] fichier le fichier dictionnaire
      * \post Une instance de la classe Dictionnaire est initialisée
      */
-    Dictionnaire::Dictionnaire(std::ifstream &fichier) : racine(nullptr), cpt(0) {
+    Dictionnaire::Dictionnaire(std::ifstream &fichier) : racine(nullptr), cpt(0), generation(0), nbThreadsEnBloc(0), nbParcours(0), comptageAcces(false), enregistreur(0) {
         if (fichier) {
+            std::string motAnglais, motTraduit;
             for (std::string ligneDico; getline(fichier, ligneDico);) {
-                if (ligneDico[0] != '#') //Élimine les lignes d'en-tête
-                {
-                    // Le mot anglais est avant la tabulation (\t).
-                    std::string motAnglais = ligneDico.substr(0, ligneDico.find_first_of('\t'));
-
-                    // Le reste (définition) est après la tabulation (\t).
-                    std::string motTraduit = ligneDico.substr(motAnglais.length() + 1, ligneDico.length() - 1);
-
-                    //On élimine tout ce qui est entre crochets [] (possibilité de 2 ou plus)
-                    std::size_t pos = motTraduit.find_first_of('[');
-                    while (pos != std::string::npos) {
-                        std::size_t longueur_crochet = motTraduit.find_first_of(']') - pos + 1;
-                        motTraduit.replace(pos, longueur_crochet, "");
-                        pos = motTraduit.find_first_of('[');
-                    }
-
-                    //On élimine tout ce qui est entre deux parenthèses () (possibilité de 2 ou plus)
-                    pos = motTraduit.find_first_of('(');
-                    while (pos != std::string::npos) {
-                        std::size_t longueur_crochet = motTraduit.find_first_of(')') - pos + 1;
-                        motTraduit.replace(pos, longueur_crochet, "");
-                        pos = motTraduit.find_first_of('(');
-                    }
-
-                    //Position d'un tilde, s'il y a lieu
-                    std::size_t posT = motTraduit.find_first_of('~');
-
-                    //Position d'un tilde, s'il y a lieu
-                    std::size_t posD = motTraduit.find_first_of(':');
-
-                    if (posD < posT) {
-                        //Quand le ':' est avant le '~', le mot français précède le ':'
-                        motTraduit = motTraduit.substr(0, posD);
-                    } else {
-                        //Quand le ':' est après le '~', le mot français suit le ':'
-                        if (posT < posD) {
-                            motTraduit = motTraduit.substr(posD, motTraduit.find_first_of("([,;\n", posD));
-                        } else {
-                            //Quand il n'y a ni ':' ni '~', on extrait simplement ce qu'il y a avant un caractère de limite
-                            motTraduit = motTraduit.substr(0, motTraduit.find_first_of("([,;\n"));
-                        }
-                    }
-
-                    //On ajoute le mot au dictionnaire
-                    ajouteMot(motAnglais, motTraduit);
+                if (_analyserLigne(ligneDico, motAnglais, motTraduit)) {
+                    //On ajoute le mot au dictionnaire; les deux chaines sont reaffectees a la ligne suivante
+                    ajouteMot(std::move(motAnglais), std::move(motTraduit));
                     //std::cout<<motAnglais << " - " << motTraduit<<std::endl;
                 }
             }
@@ -83,6 +52,12 @@ namespace TP3 {
      *  \post L'instance de Dictionnaire est détruite
      */
     Dictionnaire::~Dictionnaire() {
+        //Les parcours de suggereCorrectionsAsync s'arretent a leur prochaine tranche; on attend qu'ils aient fini
+        arretParcours.request_stop();
+        {
+            std::unique_lock<std::mutex> verrouCompte(verrouParcours);
+            finParcours.wait(verrouCompte, [this] { return nbParcours == 0; });
+        }
         _detruire(racine);
     }
 
@@ -93,13 +68,17 @@ namespace TP3 {
      * \post L'élément et sa traduction est ajouté, si le mot existait deja, seul la traduction est ajoutee
      */
     void Dictionnaire::ajouteMot(const std::string &motOriginal, const std::string &motTraduit) {
-        //Si le mot existe deja, on ne fait qu'ajouter la traduction au vectuer de ce mot
-        if (appartient(motOriginal)){
-            NoeudDictionnaire *& mot = _trouverMot(racine, motOriginal);
-            mot->traductions.push_back(motTraduit);
-        } else{ //Sinon on ajoute le mot et sa traduction a l'arbre
-            _insererAVL(racine, motOriginal, motTraduit);
-        }
+        _ajouter(motOriginal, std::string(motTraduit));
+    }
+
+    /**
+     * \brief Ajoute un mot en deplacant les chaines dans le dictionnaire
+     * \param[in] motOriginal le mot a ajouter en anglais
+     * \param[in] motTraduit la traduction du mot a ajouter
+     * \post L'élément et sa traduction est ajouté, si le mot existait deja, seul la traduction est ajoutee
+     */
+    void Dictionnaire::ajouteMot(std::string &&motOriginal, std::string &&motTraduit) {
+        _ajouter(std::move(motOriginal), std::move(motTraduit));
     }
 
     /**
@@ -108,18 +87,127 @@ namespace TP3 {
      * \pre L'élément est pas dans l'arbre
      * \post L'élément est enlevé
      */
-    void Dictionnaire::supprimeMot(const std::string &motOriginal) {
+    void Dictionnaire::supprimeMot(std::string_view motOriginal) {
+        //La vue peut designer un mot du dictionnaire, que la suppression deplace: on en garde une copie
+        const std::string motASupprimer(motOriginal);
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        _enregistrer(TRACE_SUPPRIME, motASupprimer);
         //Exception	logic_error si l'arbre est vide
-        if (estVide()){
+        if (cpt == 0){
             throw std::logic_error("supprimerMot: l'arbre est vide.");
         }
         //Exception	logic_error si le mot n'appartient pas au dictionnaire
-        if (!(appartient(motOriginal))){
+        NoeudDictionnaire *noeudMot = _appartient(racine, motASupprimer);
+        if (noeudMot == 0){
             throw std::logic_error("supprimerMot: le mot n'appartient pas au dictionnaire.");
 
         }
-        _supprimerAVL(racine, motOriginal);
+        _retirerMot(motASupprimer, noeudMot);
+    }
+
+    /**
+     * \brief Enlever une traduction d'un mot, et le mot lui-meme s'il n'a plus de traduction
+     * \param[in] motOriginal le mot dont on retire la traduction
+     * \param[in] motTraduit la traduction a retirer
+     * \post Une occurrence de la traduction est enlevée
+     */
+    void Dictionnaire::supprimeTraduction(std::string_view motOriginal, std::string_view motTraduit) {
+        //Comme pour supprimeMot, les vues peuvent designer des chaines du dictionnaire
+        const std::string motASupprimer(motOriginal), traductionASupprimer(motTraduit);
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        _enregistrer(TRACE_SUPPRIME_TRADUCTION, motASupprimer, traductionASupprimer);
+        NoeudDictionnaire *noeudMot = _appartient(racine, motASupprimer);
+        //Exception	logic_error si le mot n'appartient pas au dictionnaire
+        if (noeudMot == 0){
+            throw std::logic_error("supprimeTraduction: le mot n'appartient pas au dictionnaire.");
+        }
+        std::vector<std::string>::iterator traduction =
+                std::find(noeudMot->traductions.begin(), noeudMot->traductions.end(), traductionASupprimer);
+        //Exception	logic_error si la traduction n'appartient pas au mot
+        if (traduction == noeudMot->traductions.end()){
+            throw std::logic_error("supprimeTraduction: la traduction n'appartient pas au mot.");
+        }
+        _retirerTraduction(motASupprimer, noeudMot, traduction);
+    }
+
+    /**
+     * \brief Recharge le dictionnaire en n'appliquant que les differences avec le nouveau fichier
+     *        Tout le fichier est lu et verifie avant la premiere modification: une erreur de lecture
+     *        laisse le dictionnaire intact.
+     * \param[in] fichier la nouvelle version du fichier dictionnaire
+     * \return les statistiques du rechargement
+     * \pre Aucune autre modification n'est faite au dictionnaire pendant le rechargement
+     * \post Le dictionnaire a le meme contenu que s'il avait ete construit a partir du fichier
+     */
+    Dictionnaire::StatistiquesRechargement Dictionnaire::recharge(std::ifstream &fichier) {
+        std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+        StatistiquesRechargement stats = {0, 0, 0, 0, 0, 0.0};
+
+        //Exception	logic_error si le fichier n'est pas ouvert: on viderait le dictionnaire
+        if (!fichier.is_open() || !fichier) {
+            throw std::logic_error("recharge: le fichier n'est pas ouvert.");
+        }
+        //La lecture du fichier se fait sans verrou: les requetes ne sont pas bloquees.
+        //Dans un fichier trie, chaque mot s'insere a la fin de la table, en temps constant.
+        std::map<std::string, std::vector<std::string>> nouveau;
+        std::string motAnglais, motTraduit;
+        for (std::string ligneDico; getline(fichier, ligneDico);) {
+            if (_analyserLigne(ligneDico, motAnglais, motTraduit)) {
+                std::map<std::string, std::vector<std::string>>::iterator entree = nouveau.end();
+                if (nouveau.empty() || std::prev(entree)->first != motAnglais) {
+                    entree = nouveau.try_emplace(entree, motAnglais);
+                } else {
+                    --entree;
+                }
+                entree->second.push_back(std::move(motTraduit));
+            }
+        }
+        //Exception	runtime_error si la lecture s'est arretee avant la fin: les mots manquants seraient supprimes
+        if (fichier.bad()) {
+            throw std::runtime_error("recharge: erreur de lecture du fichier.");
+        }
+
+        //Comparaison avec le contenu actuel, en lecture seulement.
+        //Apres le parcours, il ne reste dans nouveau que les mots a ajouter.
+        std::vector<std::string> motsSupprimes;
+        std::vector<std::pair<std::string, std::vector<std::string>>> remplacements;
+        {
+            std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+            _parcoursDifferences(nouveau, motsSupprimes, remplacements);
+        }
+        stats.motsAjoutes = nouveau.size();
+        stats.motsSupprimes = motsSupprimes.size();
+        stats.motsTouches = stats.motsAjoutes + stats.motsSupprimes + remplacements.size();
+
+        //Chaque changement prend le verrou d'ecriture separement pour laisser passer les lecteurs.
+        //Les changements sont appliques sans lever d'exception: un mot deja retire est simplement ignore.
+        for (const std::string &mot : motsSupprimes) {
+            std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+            NoeudDictionnaire *noeudMot = _appartient(racine, mot);
+            if (noeudMot != 0) {
+                _enregistrer(TRACE_SUPPRIME, mot);
+                _retirerMot(mot, noeudMot);
+            }
+        }
+        //La liste entiere est remplacee, pour avoir les traductions dans l'ordre du fichier
+        for (std::pair<std::string, std::vector<std::string>> &remplacement : remplacements) {
+            std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+            NoeudDictionnaire *noeudMot = _appartient(racine, remplacement.first);
+            if (noeudMot != 0) {
+                _remplacerTraductions(remplacement.first, noeudMot, std::move(remplacement.second),
+                                      stats.traductionsAjoutees, stats.traductionsSupprimees);
+            }
+        }
+        //On extrait les noeuds de la table pour pouvoir deplacer les mots, qui en sont les cles
+        while (!nouveau.empty()) {
+            std::map<std::string, std::vector<std::string>>::node_type motNouveau = nouveau.extract(nouveau.begin());
+            _ajouterTraductions(std::move(motNouveau.key()), std::move(motNouveau.mapped()));
+        }
+
+        stats.dureeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - debut).count();
+        return stats;
     }
+
     /**
     * \brief Compare 2 strings et retourne la similarite entre les 2 en pourcentage
     * Une partie de cette fonction a ete prise ici: https://www.techiedelight.com/find-similarity-between-two-strings-in-cpp/
@@ -127,12 +215,16 @@ namespace TP3 {
     * \param[in] mot2 le deuxieme mot a comparer
     * \return un double representant le pourcentage de similarite (1 etant 2 mots identiques)
     */
-    double Dictionnaire::similitude(const std::string &mot1, const std::string &mot2) const {
-        double max_length = std::max(mot1.length(), mot2.length());
-        if (max_length > 0) {
-            return (max_length - _getEditDistance(mot1, mot2)) / max_length;;
+    double Dictionnaire::similitude(std::string_view mot1, std::string_view mot2) const {
+        //Presque tous les mots anglais sont en ASCII: on compare alors directement les octets
+        if (_estAscii(mot1) && _estAscii(mot2)) {
+            return _similitude(mot1.data(), mot1.size(), mot2.data(), mot2.size());
         }
-        return 1.0;
+        //Sinon, on compare les points de code pour qu'un caractere accentue ne compte pas pour deux
+        thread_local std::vector<char32_t> points1, points2;
+        _decoderUtf8(mot1, points1);
+        _decoderUtf8(mot2, points2);
+        return _similitude(points1.data(), points1.size(), points2.data(), points2.size());
     }
 
     /**
@@ -140,29 +232,43 @@ namespace TP3 {
     * \param[in] motMalEcrit le mot inconnu
     * \return un vecteur contenant au plus 5 suggestions
     */
-    std::vector<std::string> Dictionnaire::suggereCorrections(const std::string &motMalEcrit) {
-        std::vector<std::pair <double, std::string>> comparaison;
-        std::vector<std::string> suggestions;
+    std::vector<std::string> Dictionnaire::suggereCorrections(std::string_view motMalEcrit) const {
+        //Les vues pointent sur les mots de l'arbre: le choix se fait donc sous le meme verrou
+        std::vector<std::pair <double, std::string_view>> comparaison;
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        _enregistrer(TRACE_SUGGERE, motMalEcrit);
         _parcousSuggestion(racine, comparaison, motMalEcrit);
-        sort(comparaison.rbegin(), comparaison.rend());
+        return _choisirSuggestions(comparaison);
+    }
 
-        int i = 0;
-        while (i < comparaison.size() and suggestions.size() < LIMITE_SUGGESTIONS){
-            suggestions.push_back(comparaison[i].second);
-            i++;
+    /**
+    * \brief donne une vue sur les traductions d'un mot, sans copie
+    * \param[in] mot le mot a traduire
+    * \return une vue sur les traductions, vide si le mot n'est pas dans le dictionnaire
+    */
+    std::span<const std::string> Dictionnaire::traduit(std::string_view mot) const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        _enregistrer(TRACE_TRADUIT, mot);
+        NoeudDictionnaire* noeudMot = _chercher(mot);
+        if (noeudMot == 0) {
+            return std::span<const std::string>();
         }
-        return suggestions;
+        return std::span<const std::string>(noeudMot->traductions);
     }
 
     /**
     * \brief cree un vecteur de traductions pour un mot donnee
     * \param[in] mot le mot a traduire
-    * \return un vecteur contenant au plus 5 suggestions
+    * \return un vecteur contenant les traductions, vide si le mot n'est pas dans le dictionnaire
     */
-    std::vector<std::string> Dictionnaire::traduit(const std::string &mot) {
+    std::vector<std::string> Dictionnaire::traduitCopie(std::string_view mot) const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        _enregistrer(TRACE_TRADUIT, mot);
         std::vector<std::string> traductions;
-        NoeudDictionnaire* noeudMot = _trouverMot(racine, mot);
-        traductions = noeudMot->traductions;
+        NoeudDictionnaire* noeudMot = _chercher(mot);
+        if (noeudMot != 0) {
+            traductions = noeudMot->traductions;
+        }
         return traductions;
     }
 
@@ -171,8 +277,311 @@ namespace TP3 {
     * \param[in] mot le mot a verifier
     * \return un bool a vrai si il s'y trouve
     */
-    bool Dictionnaire::appartient(const std::string &mot) {
-        return (_appartient(racine, mot) != 0);
+    bool Dictionnaire::appartient(std::string_view mot) const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        _enregistrer(TRACE_APPARTIENT, mot);
+        return (_chercher(mot) != 0);
+    }
+
+    /**
+    * \brief trouve les mots anglais qui se traduisent par le mot donne
+    * \param[in] motTraduit le mot francais
+    * \return les mots anglais correspondants, en ordre et sans doublon
+    */
+    std::vector<std::string> Dictionnaire::traduitInverse(std::string_view motTraduit) const {
+        std::vector<std::string> mots;
+        {
+            std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+            if (indexInverse) {
+                IndexInverse::const_iterator entree = indexInverse->find(motTraduit);
+                if (entree != indexInverse->end()) {
+                    mots = entree->second;
+                }
+            } else {
+                verrouLecture.unlock();
+                //Premier appel: on construit l'index, a moins qu'un autre thread l'ait fait entre-temps
+                std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+                if (!indexInverse) {
+                    indexInverse.reset(new IndexInverse());
+                    _construireIndexInverse(racine);
+                }
+                IndexInverse::const_iterator entree = indexInverse->find(motTraduit);
+                if (entree != indexInverse->end()) {
+                    mots = entree->second;
+                }
+            }
+        }
+        std::sort(mots.begin(), mots.end());
+        mots.erase(std::unique(mots.begin(), mots.end()), mots.end());
+        return mots;
+    }
+
+    /**
+    * \brief estime la memoire occupee par l'index inverse
+    * \return le nombre d'octets, 0 si l'index n'est pas construit
+    */
+    std::size_t Dictionnaire::memoireIndexInverse() const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        if (!indexInverse) {
+            return 0;
+        }
+        std::size_t octets = sizeof(*indexInverse) + indexInverse->bucket_count() * sizeof(void *);
+        for (const std::pair<const std::string, std::vector<std::string>> &entree : *indexInverse) {
+            octets += sizeof(entree) + 2 * sizeof(void *); //Noeud de la table: l'entree, le chainage et le hash
+            octets += _octetsChaine(entree.first);
+            octets += entree.second.capacity() * sizeof(std::string);
+            for (const std::string &mot : entree.second) {
+                octets += _octetsChaine(mot);
+            }
+        }
+        return octets;
+    }
+
+    /**
+    * \brief calcule le profil de l'arbre: forme, equilibre et memoire
+    * \return le profil
+    */
+    Dictionnaire::ProfilArbre Dictionnaire::profil() const {
+        ProfilArbre resultat;
+        resultat.nbNoeuds = 0;
+        resultat.profondeurMax = 0;
+        resultat.octetsNoeuds = resultat.octetsMots = resultat.octetsTraductions = 0;
+        resultat.nbAcces = 0;
+        std::size_t sommeProfondeurs = 0;
+        unsigned long long sommeComparaisons = 0, sommeComparaisonsArbre = 0;
+        {
+            std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+            resultat.hauteur = racine == 0 ? -1 : racine->hauteur;
+            _profiler(racine, 0, resultat, sommeProfondeurs, sommeComparaisons, sommeComparaisonsArbre);
+        }
+        //Les profondeurs sont comptees en comparaisons: la racine en coute une
+        resultat.profondeurMoyenne = resultat.nbNoeuds == 0 ? 0.0 : double(sommeProfondeurs) / resultat.nbNoeuds;
+        resultat.comparaisonsPonderees = resultat.nbAcces == 0 ? 0.0 : double(sommeComparaisons) / resultat.nbAcces;
+        resultat.comparaisonsPondereesArbre = resultat.nbAcces == 0 ? 0.0 : double(sommeComparaisonsArbre) / resultat.nbAcces;
+        resultat.hauteurMaxAVL = 1.44 * std::log2(resultat.nbNoeuds + 2.0) - 1.328;
+        return resultat;
+    }
+
+    /**
+    * \brief active ou desactive le comptage des acces
+    * \param[in] actif vrai pour compter les acces des recherches
+    */
+    void Dictionnaire::activeComptageAcces(bool actif) {
+        comptageAcces = actif;
+    }
+
+    /**
+    * \brief compte les acces aux mots d'un corpus d'entrainement
+    * \param[in] corpus un flux de texte, les mots separes par des espaces
+    * \post Chaque mot du corpus present dans le dictionnaire a un acces de plus
+    */
+    void Dictionnaire::entraineAcces(std::istream &corpus) {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        for (std::string mot; corpus >> mot;) {
+            NoeudDictionnaire *noeudMot = _appartient(racine, mot);
+            if (noeudMot != 0) {
+                noeudMot->acces.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+    * \brief remet a zero les acces de tous les mots
+    */
+    void Dictionnaire::reinitialiseAcces() {
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        _reinitialiserAcces(racine);
+    }
+
+    /**
+    * \brief construit la table chaude a partir des acces comptes
+    * \param[in] nbMotsChauds le nombre maximal de mots dans la table
+    * \post La table contient les mots les plus consultes (ceux qui n'ont jamais ete consultes en sont exclus)
+    */
+    void Dictionnaire::optimiseAcces(std::size_t nbMotsChauds) {
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        std::vector<std::pair<unsigned long, NoeudDictionnaire *>> noeuds;
+        _noeudsConsultes(racine, noeuds);
+
+        std::size_t nbGardes = std::min(nbMotsChauds, noeuds.size());
+        std::partial_sort(noeuds.begin(), noeuds.begin() + nbGardes, noeuds.end(),
+                          [](const std::pair<unsigned long, NoeudDictionnaire *> &a,
+                             const std::pair<unsigned long, NoeudDictionnaire *> &b) { return a.first > b.first; });
+
+        tableChaude.clear();
+        tableChaude.reserve(nbGardes);
+        for (std::size_t i = 0; i < nbGardes; i++) {
+            tableChaude.emplace(std::string_view(noeuds[i].second->mot), noeuds[i].second);
+        }
+    }
+
+    /**
+    * \brief retourne le nombre de mots dans la table chaude
+    * \return la taille de la table
+    */
+    std::size_t Dictionnaire::nbMotsChauds() const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        return tableChaude.size();
+    }
+
+    /**
+    * \brief compte les mots plus petits que le mot donne
+    * \param[in] mot le mot de reference
+    * \return le rang du mot, en partant de 0
+    */
+    std::size_t Dictionnaire::rang(std::string_view mot) const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        return _rang(racine, mot, false);
+    }
+
+    /**
+    * \brief trouve le k-ieme mot en ordre alphabetique
+    * \param[in] k le rang du mot, en partant de 0
+    * \return une vue sur le mot
+    */
+    std::string_view Dictionnaire::selectionne(std::size_t k) const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        if (k >= _taille(racine)) {
+            throw std::out_of_range("selectionne: il n'y a pas autant de mots dans le dictionnaire.");
+        }
+        NoeudDictionnaire *noeud = racine;
+        while (true) {
+            std::size_t tailleGauche = _taille(noeud->gauche);
+            if (k < tailleGauche) {
+                noeud = noeud->gauche;
+            } else if (k == tailleGauche) {
+                return noeud->mot;
+            } else {
+                k -= tailleGauche + 1;
+                noeud = noeud->droite;
+            }
+        }
+    }
+
+    /**
+    * \brief compte les mots compris dans un intervalle
+    * \param[in] motMin la borne inferieure, incluse
+    * \param[in] motMax la borne superieure, incluse
+    * \return le nombre de mots entre les deux bornes, 0 si motMax < motMin
+    */
+    std::size_t Dictionnaire::compte(std::string_view motMin, std::string_view motMax) const {
+        if (motMax < motMin) {
+            return 0;
+        }
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        return _rang(racine, motMax, true) - _rang(racine, motMin, false);
+    }
+
+    /**
+    * \brief liste une page de mots en ordre alphabetique
+    * \param[in] debut le rang du premier mot de la page
+    * \param[in] nbMots la taille de la page
+    * \return les mots de la page, moins de nbMots a la fin du dictionnaire
+    */
+    std::vector<std::string> Dictionnaire::page(std::size_t debut, std::size_t nbMots) const {
+        std::vector<std::string> mots;
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        if (debut < _taille(racine)) {
+            _lister(racine, debut, std::min(nbMots, _taille(racine) - debut), mots);
+        }
+        return mots;
+    }
+
+    /**
+    * \brief ajoute au dictionnaire tous les mots d'un autre dictionnaire
+    * \param[in] autre le dictionnaire a fusionner
+    * \post Le dictionnaire contient l'union des deux ensembles de mots
+    */
+    void Dictionnaire::fusionne(const Dictionnaire &autre) {
+        if (&autre == this) {
+            return;
+        }
+        //On copie l'autre arbre sous son propre verrou: jamais deux verrous a la fois, donc pas d'interblocage
+        NoeudDictionnaire *copie;
+        {
+            std::shared_lock<std::shared_mutex> verrouAutre(autre.verrou);
+            copie = _copier(autre.racine);
+        }
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        std::vector<NoeudDictionnaire *> ajoutes;
+        racine = _unir(racine, copie, _niveauxParalleles(), ajoutes);
+        //Seuls les mots ajoutes entrent dans le filtre: O(M) plutot qu'une reconstruction en O(N)
+        for (const NoeudDictionnaire *noeud : ajoutes) {
+            filtre.ajoute(noeud->mot);
+        }
+        _apresOperationEnBloc(false);
+    }
+
+    /**
+    * \brief enleve du dictionnaire tous les mots d'un autre dictionnaire
+    * \param[in] autre les mots a enlever
+    * \post Le dictionnaire contient la difference des deux ensembles de mots
+    */
+    void Dictionnaire::retranche(const Dictionnaire &autre) {
+        NoeudDictionnaire *copie = 0;
+        if (&autre != this) {
+            std::shared_lock<std::shared_mutex> verrouAutre(autre.verrou);
+            copie = _copier(autre.racine);
+        }
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        if (&autre == this) {
+            _detruire(racine);
+            filtre.vide();
+        } else {
+            std::vector<NoeudDictionnaire *> retires;
+            racine = _retrancher(racine, copie, _niveauxParalleles(), retires);
+            _detruire(copie);
+            //Les noeuds retires sont liberes ici, apres les taches: le filtre n'est modifie que par ce thread
+            for (NoeudDictionnaire *noeud : retires) {
+                filtre.retire(noeud->mot);
+                delete noeud;
+            }
+        }
+        _apresOperationEnBloc(false);
+    }
+
+    /**
+    * \brief garde seulement les mots qui sont aussi dans un autre dictionnaire
+    * \param[in] autre les mots a garder
+    * \post Le dictionnaire contient l'intersection des deux ensembles de mots
+    */
+    void Dictionnaire::intersecte(const Dictionnaire &autre) {
+        if (&autre == this) {
+            return;
+        }
+        NoeudDictionnaire *copie;
+        {
+            std::shared_lock<std::shared_mutex> verrouAutre(autre.verrou);
+            copie = _copier(autre.racine);
+        }
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        racine = _intersecter(racine, copie, _niveauxParalleles());
+        _detruire(copie);
+        _apresOperationEnBloc(true);
+    }
+
+    /**
+    * \brief deplace les mots plus grands ou egaux a un mot dans un autre dictionnaire
+    * \param[in] mot le premier mot a deplacer
+    * \param[out] superieurs le dictionnaire qui recoit les mots, vide au depart
+    * \post Les deux dictionnaires restent des arbres AVL
+    */
+    void Dictionnaire::separe(std::string_view mot, Dictionnaire &superieurs) {
+        if (&superieurs == this) {
+            throw std::logic_error("separe: on ne peut pas separer un dictionnaire dans lui-meme.");
+        }
+        //La vue peut designer un mot du dictionnaire, que la separation deplace
+        const std::string motSeparation(mot);
+        std::scoped_lock verrous(verrou, superieurs.verrou);
+        if (superieurs.racine != 0) {
+            throw std::logic_error("separe: le dictionnaire qui recoit les mots doit etre vide.");
+        }
+        NoeudDictionnaire *gauche, *trouve, *droite;
+        _separer(racine, motSeparation, gauche, trouve, droite);
+        racine = gauche;
+        superieurs.racine = trouve != 0 ? _joindre(0, trouve, droite) : droite;
+        _apresOperationEnBloc(true);
+        superieurs._apresOperationEnBloc(true);
     }
 
     /**
@@ -180,11 +589,355 @@ namespace TP3 {
     * \return un bool a vrai si il l'est
     */
     bool Dictionnaire::estVide() const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
         return cpt == 0;
     }
 
+    /**
+    * \brief redimensionne le filtre de Bloom et le reconstruit
+    * \param[in] capacite le nombre de mots prevu
+    * \param[in] tauxFauxPositifs le taux de faux positifs vise a pleine capacite
+    * \post Le filtre contient tous les mots du dictionnaire
+    */
+    void Dictionnaire::configureFiltre(std::size_t capacite, double tauxFauxPositifs) {
+        //On valide avant de prendre le verrou en construisant le nouveau filtre
+        FiltreBloomCompteur nouveau(capacite, tauxFauxPositifs);
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        while (nouveau.capacite() < static_cast<std::size_t>(cpt)) {
+            nouveau = FiltreBloomCompteur(2 * nouveau.capacite(), tauxFauxPositifs);
+        }
+        filtre = std::move(nouveau);
+        _remplirFiltre(racine);
+    }
+
+    /**
+    * \brief fixe le nombre de threads des operations en bloc
+    * \param[in] nbThreads le nombre de threads, 0 pour le nombre de coeurs
+    */
+    void Dictionnaire::configureParallelisme(unsigned int nbThreads) {
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        nbThreadsEnBloc = nbThreads;
+    }
+
+    /**
+    * \brief retourne l'etat du filtre de Bloom
+    * \return les dimensions du filtre et son taux de faux positifs estime
+    */
+    Dictionnaire::StatistiquesFiltre Dictionnaire::statistiquesFiltre() const {
+        std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+        StatistiquesFiltre stats;
+        stats.capacite = filtre.capacite();
+        stats.tauxVise = filtre.tauxVise();
+        stats.nbMots = filtre.nbElements();
+        stats.nbHachages = filtre.nbHachages();
+        stats.octets = filtre.octets();
+        stats.tauxFauxPositifsEstime = filtre.tauxFauxPositifsEstime();
+        return stats;
+    }
+
+    /**
+    * \brief commence ou arrete l'enregistrement des operations
+    * \param[in] nouvelEnregistreur l'enregistreur de trace, ou nullptr pour arreter
+    * \post Les appels suivants sont enregistres par le nouvel enregistreur seulement
+    */
+    void Dictionnaire::enregistreTrace(EnregistreurTrace *nouvelEnregistreur) {
+        //Le verrou d'ecriture attend la fin des appels qui utilisent encore l'ancien enregistreur
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        enregistreur = nouvelEnregistreur;
+    }
+
+    /**
+    * \brief verifie de facon asynchrone si un mot appartient au dictionnaire
+    * \param[in] mot le mot a verifier
+    * \return une tache deja terminee contenant vrai si le mot s'y trouve
+    */
+    Tache<bool> Dictionnaire::appartientAsync(std::string_view mot) {
+        co_return appartient(mot);
+    }
+
+    /**
+    * \brief trouve de facon asynchrone les traductions d'un mot
+    * \param[in] mot le mot a traduire
+    * \return une tache deja terminee contenant les traductions
+    */
+    Tache<std::vector<std::string>> Dictionnaire::traduitAsync(std::string_view mot) {
+        co_return traduitCopie(mot);
+    }
+
+    /**
+    * \brief cree un vecteur de suggestions sur un thread de l'executeur, en cedant sa place regulierement
+    *        Le parcours est en ordre: si l'arbre change entre deux tranches, il reprend apres le dernier mot examine.
+    * \param[in] motMalEcrit le mot inconnu
+    * \param[in] executeur l'executeur qui fait le parcours
+    * \param[in] annulation permet a l'appelant d'abandonner la recherche
+    * \return une tache contenant au plus 5 suggestions
+    */
+    Tache<std::vector<std::string>> Dictionnaire::suggereCorrectionsAsync(std::string motMalEcrit,
+                                                                          ExecuteurFond &executeur,
+                                                                          std::stop_token annulation) {
+        //Compte le parcours tant que la coroutine l'execute: le destructeur attend qu'il n'en reste aucun
+        struct ParcoursEnCours {
+            Dictionnaire &dictionnaire;
+            explicit ParcoursEnCours(Dictionnaire &p_dictionnaire) : dictionnaire(p_dictionnaire) {
+                std::lock_guard<std::mutex> verrouCompte(dictionnaire.verrouParcours);
+                dictionnaire.nbParcours++;
+            }
+            ~ParcoursEnCours() {
+                std::lock_guard<std::mutex> verrouCompte(dictionnaire.verrouParcours);
+                if (--dictionnaire.nbParcours == 0) {
+                    dictionnaire.finParcours.notify_all();
+                }
+            }
+        } parcoursEnCours(*this);
+        {
+            std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+            _enregistrer(TRACE_SUGGERE, motMalEcrit);
+        }
+        //Arret demande si la tache est detruite avant la fin
+        std::stop_token abandon = co_await Tache<std::vector<std::string>>::jetonArret();
+        co_await executeur.transfere();
+
+        std::vector<std::pair<double, std::string>> trouves;   //Des copies: un noeud peut disparaitre entre deux tranches
+        std::vector<NoeudDictionnaire *> pile;  //Le prochain noeud en ordre, puis ses ancetres qui le suivent
+        std::string dernierMot;                 //Le dernier mot examine
+        unsigned long generationParcours = 0;
+        bool commence = false, termine = false;
+
+        while (!termine) {
+            if (annulation.stop_requested() || abandon.stop_requested() || arretParcours.stop_requested()) {
+                throw std::system_error(std::make_error_code(std::errc::operation_canceled),
+                                        "suggereCorrectionsAsync");
+            }
+            std::shared_lock<std::shared_mutex> verrouLecture(verrou);
+            //Les noeuds de la pile ne sont plus valides si la forme de l'arbre a change: on se repositionne
+            //sur le premier mot qui suit le dernier mot examine
+            if (!commence || generationParcours != generation) {
+                pile.clear();
+                for (NoeudDictionnaire *noeud = racine; noeud != 0;) {
+                    if (!commence || noeud->mot > dernierMot) {
+                        pile.push_back(noeud);
+                        noeud = noeud->gauche;
+                    } else {
+                        noeud = noeud->droite;
+                    }
+                }
+                generationParcours = generation;
+                commence = true;
+            }
+            NoeudDictionnaire *dernier = 0;
+            for (std::size_t i = 0; i < TRANCHE_SUGGESTIONS && !pile.empty(); i++) {
+                dernier = pile.back();
+                pile.pop_back();
+                double simi = similitude(motMalEcrit, dernier->mot);
+                if (simi >= 0.5) {
+                    trouves.emplace_back(simi, dernier->mot);
+                }
+                for (NoeudDictionnaire *suivant = dernier->droite; suivant != 0; suivant = suivant->gauche) {
+                    pile.push_back(suivant);
+                }
+            }
+            termine = pile.empty();
+            if (!termine) {
+                dernierMot = dernier->mot;
+                //On cede sa place aux autres taches entre deux tranches, sans garder le verrou
+                verrouLecture.unlock();
+                co_await executeur.transfere();
+            }
+        }
+
+        std::vector<std::pair<double, std::string_view>> comparaison;
+        for (const std::pair<double, std::string> &trouve : trouves) {
+            comparaison.emplace_back(trouve.first, trouve.second);
+        }
+        co_return _choisirSuggestions(comparaison);
+    }
+
     // Complétez ici l'implémentation avec vos méthodes privées.
 
+    /**
+     * \brief Ajoute un mot et sa traduction; partie commune aux versions de ajouteMot
+     * \param[in] motOriginal le mot en anglais, copie ou deplace selon son type seulement s'il est nouveau
+     * \param[in] motTraduit la traduction, deplacee dans le dictionnaire
+     * \post L'élément et sa traduction est ajouté, si le mot existait deja, seul la traduction est ajoutee
+     */
+    template<typename MotOriginal>
+    void Dictionnaire::_ajouter(MotOriginal &&motOriginal, std::string &&motTraduit) {
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        _enregistrer(TRACE_AJOUTE, motOriginal, motTraduit);
+        //L'index inverse garde ses propres copies; on les fait avant de deplacer les chaines
+        _ajouterIndexInverse(motOriginal, motTraduit);
+        //Si le mot existe deja, on ne fait qu'ajouter la traduction au vectuer de ce mot
+        NoeudDictionnaire *noeudMot = _appartient(racine, motOriginal);
+        if (noeudMot != 0){
+            noeudMot->traductions.push_back(std::move(motTraduit));
+        } else{ //Sinon on ajoute le mot et sa traduction a l'arbre
+            filtre.ajoute(motOriginal);
+            //Les rotations changent la forme de l'arbre: les parcours asynchrones doivent se repositionner
+            generation++;
+            _insererAVL(racine, std::string(std::forward<MotOriginal>(motOriginal)), std::move(motTraduit));
+            if (filtre.nbElements() > filtre.capacite()) {
+                _reconstruireFiltre(2 * filtre.capacite(), filtre.tauxVise());
+            }
+        }
+    }
+
+    /**
+     * \brief Ajoute un mot et toutes ses traductions sous une seule prise du verrou, sans copier les chaines
+     * \param[in] motOriginal le mot en anglais, deplace dans le noeud s'il est nouveau
+     * \param[in] traductions les traductions, deplacees dans le dictionnaire
+     * \pre traductions n'est pas vide
+     * \post Le mot a toutes les traductions donnees, en plus de celles qu'il avait deja
+     */
+    void Dictionnaire::_ajouterTraductions(std::string &&motOriginal, std::vector<std::string> &&traductions) {
+        std::unique_lock<std::shared_mutex> verrouEcriture(verrou);
+        for (const std::string &traduction : traductions) {
+            _enregistrer(TRACE_AJOUTE, motOriginal, traduction);
+            _ajouterIndexInverse(motOriginal, traduction);
+        }
+        std::vector<std::string>::iterator traduction = traductions.begin();
+        NoeudDictionnaire *noeudMot = _appartient(racine, motOriginal);
+        if (noeudMot == 0) {
+            filtre.ajoute(motOriginal);
+            generation++;
+            //Le mot est deplace dans le nouveau noeud, qu'on garde pour y deplacer les autres traductions
+            noeudMot = _insererAVL(racine, std::move(motOriginal), std::move(*traduction));
+            ++traduction;
+            if (filtre.nbElements() > filtre.capacite()) {
+                _reconstruireFiltre(2 * filtre.capacite(), filtre.tauxVise());
+            }
+        }
+        for (; traduction != traductions.end(); ++traduction) {
+            noeudMot->traductions.push_back(std::move(*traduction));
+        }
+    }
+
+    /**
+     * \brief Ajoute un mot dont la traduction vient d'etre construite par ajouteMotEnPlace
+     * \param[in] motOriginal le mot en anglais, copie seulement s'il est nouveau
+     * \param[in] motTraduit la traduction, deplacee dans le dictionnaire
+     */
+    void Dictionnaire::_ajouterEnPlace(std::string_view motOriginal, std::string &&motTraduit) {
+        _ajouter(motOriginal, std::move(motTraduit));
+    }
+
+    /**
+     * \brief Extrait le mot anglais et sa traduction d'une ligne du fichier dictionnaire
+     * \param[in] ligneDico la ligne lue dans le fichier
+     * \param[out] motAnglais le mot anglais de la ligne
+     * \param[out] motTraduit la traduction nettoyee de la ligne
+     * \return false si la ligne est une ligne d'en-tete, true sinon
+     */
+    bool Dictionnaire::_analyserLigne(const std::string &ligneDico, std::string &motAnglais, std::string &motTraduit) const {
+        //Un fichier enregistre avec une marque d'ordre des octets (BOM) UTF-8 la porte au debut de sa premiere ligne
+        std::size_t debut = ligneDico.compare(0, 3, "\xEF\xBB\xBF") == 0 ? 3 : 0;
+        if (ligneDico.size() <= debut || ligneDico[debut] == '#') //Élimine les lignes d'en-tête (et les lignes vides)
+        {
+            return false;
+        }
+
+        // Le mot anglais est avant la tabulation (\t).
+        std::size_t tabulation = ligneDico.find_first_of('\t', debut);
+        if (tabulation == std::string::npos) {
+            return false;
+        }
+        motAnglais = ligneDico.substr(debut, tabulation - debut);
+
+        // Le reste (définition) est après la tabulation (\t).
+        motTraduit = ligneDico.substr(tabulation + 1);
+
+        //On élimine tout ce qui est entre crochets [] (possibilité de 2 ou plus)
+        std::size_t pos = motTraduit.find_first_of('[');
+        while (pos != std::string::npos) {
+            std::size_t longueur_crochet = motTraduit.find_first_of(']') - pos + 1;
+            motTraduit.replace(pos, longueur_crochet, "");
+            pos = motTraduit.find_first_of('[');
+        }
+
+        //On élimine tout ce qui est entre deux parenthèses () (possibilité de 2 ou plus)
+        pos = motTraduit.find_first_of('(');
+        while (pos != std::string::npos) {
+            std::size_t longueur_crochet = motTraduit.find_first_of(')') - pos + 1;
+            motTraduit.replace(pos, longueur_crochet, "");
+            pos = motTraduit.find_first_of('(');
+        }
+
+        //Position d'un tilde, s'il y a lieu
+        std::size_t posT = motTraduit.find_first_of('~');
+
+        //Position d'un tilde, s'il y a lieu
+        std::size_t posD = motTraduit.find_first_of(':');
+
+        if (posD < posT) {
+            //Quand le ':' est avant le '~', le mot français précède le ':'
+            motTraduit = motTraduit.substr(0, posD);
+        } else {
+            //Quand le ':' est après le '~', le mot français suit le ':'
+            if (posT < posD) {
+                motTraduit = motTraduit.substr(posD, motTraduit.find_first_of("([,;\n", posD));
+            } else {
+                //Quand il n'y a ni ':' ni '~', on extrait simplement ce qu'il y a avant un caractère de limite
+                motTraduit = motTraduit.substr(0, motTraduit.find_first_of("([,;\n"));
+            }
+        }
+
+        //Les delimiteurs sont tous ASCII: les coupes et le rognage ne separent jamais un caractere UTF-8
+        _rogner(motAnglais);
+        _rogner(motTraduit);
+        return !motAnglais.empty();
+    }
+
+    /**
+     * \brief Ajoute toutes les traductions d'un sous-arbre a l'index inverse
+     * \param[in] p_root Le sous-arbre a indexer
+     * \post L'arbre est inchangé
+     */
+    void Dictionnaire::_construireIndexInverse(NoeudDictionnaire *p_root) const {
+        if (p_root != 0) {
+            for (const std::string &traduction : p_root->traductions) {
+                (*indexInverse)[traduction].push_back(p_root->mot);
+            }
+            _construireIndexInverse(p_root->gauche);
+            _construireIndexInverse(p_root->droite);
+        }
+    }
+
+    /**
+     * \brief Ajoute une occurrence d'un mot a l'index inverse, s'il est construit
+     * \param[in] motOriginal le mot en anglais
+     * \param[in] motTraduit sa traduction
+     */
+    void Dictionnaire::_ajouterIndexInverse(std::string_view motOriginal, std::string_view motTraduit) {
+        if (!indexInverse) {
+            return;
+        }
+        IndexInverse::iterator entree = indexInverse->find(motTraduit);
+        if (entree == indexInverse->end()) {
+            entree = indexInverse->emplace(motTraduit, std::vector<std::string>()).first;
+        }
+        entree->second.emplace_back(motOriginal);
+    }
+
+    /**
+     * \brief Retire une occurrence du couple mot / traduction de l'index inverse, s'il est construit
+     * \param[in] motOriginal le mot anglais
+     * \param[in] motTraduit sa traduction
+     */
+    void Dictionnaire::_retirerIndexInverse(std::string_view motOriginal, std::string_view motTraduit) {
+        if (!indexInverse) {
+            return;
+        }
+        IndexInverse::iterator entree = indexInverse->find(motTraduit);
+        if (entree != indexInverse->end()) {
+            std::vector<std::string>::iterator mot = std::find(entree->second.begin(), entree->second.end(), motOriginal);
+            if (mot != entree->second.end()) {
+                entree->second.erase(mot);
+            }
+            if (entree->second.empty()) {
+                indexInverse->erase(entree);
+            }
+        }
+    }
+
     /**
      * \brief Détruire un sous-arbre. Fonction récursive auxiliaire pour le destructeur
      * \post Le sous-arbre est détruit
@@ -208,7 +961,7 @@ namespace TP3 {
      * \post L'arbre est inchangée
      */
         Dictionnaire::NoeudDictionnaire *Dictionnaire::_appartient
-            (NoeudDictionnaire *const &p_root, const std::string &mot) const {
+            (NoeudDictionnaire *const &p_root, std::string_view mot) const {
         //Cas arbre vide
         if (p_root == 0) {
             return 0;
@@ -225,7 +978,87 @@ namespace TP3 {
         else {
             return _appartient(p_root->droite, mot);
         }
-        //Si on retourne 0, c'est qu'on est arrive a un noeud vide, donc le mot n'est pas dans le dico.
+        //Si on retourne 0, c'est qu'on est arrive a un noeud vide, donc le mot n'est pas dans le dico.
+    }
+
+    /**
+     * \brief Cherche un mot dans la table chaude, puis dans l'arbre
+     * \param[in] mot L'élément à rechercher
+     * \return Pointeur sur le noeud contenant la donnée, 0 si le mot est absent
+     * \pre Le verrou est pris (en lecture au moins)
+     * \post Si le comptage est actif, l'accès au mot est compté
+     */
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_chercher(std::string_view mot) const {
+        NoeudDictionnaire *noeudMot = 0;
+        if (!tableChaude.empty()) {
+            std::unordered_map<std::string_view, NoeudDictionnaire *, HachageTransparent, std::equal_to<>>::const_iterator
+                    entree = tableChaude.find(mot);
+            if (entree != tableChaude.end()) {
+                noeudMot = entree->second;
+            }
+        }
+        //Un mot que le filtre rejette n'est certainement pas dans l'arbre
+        if (noeudMot == 0 && filtre.contientPeutEtre(mot)) {
+            noeudMot = _appartient(racine, mot);
+        }
+        if (noeudMot != 0 && comptageAcces.load(std::memory_order_relaxed)) {
+            noeudMot->acces.fetch_add(1, std::memory_order_relaxed);
+        }
+        return noeudMot;
+    }
+
+    /**
+     * \brief Echange le contenu de deux noeuds, sans toucher a leur position dans l'arbre
+     * \param[in] p_noeud1 Le premier noeud
+     * \param[in] p_noeud2 Le deuxieme noeud
+     */
+    void Dictionnaire::_echangerContenu(NoeudDictionnaire *p_noeud1, NoeudDictionnaire *p_noeud2) {
+        //Les cles de la table chaude sont des vues sur les mots des noeuds: un mot chaud qui change de noeud
+        //est retire avant l'echange, puis remis avec son nouveau noeud
+        bool chaud1 = false, chaud2 = false;
+        if (!tableChaude.empty()) {
+            chaud1 = tableChaude.erase(p_noeud1->mot) > 0;
+            chaud2 = tableChaude.erase(p_noeud2->mot) > 0;
+        }
+        std::swap(p_noeud1->mot, p_noeud2->mot);
+        std::swap(p_noeud1->traductions, p_noeud2->traductions);
+        p_noeud1->acces = p_noeud2->acces.exchange(p_noeud1->acces);
+        if (chaud1) {
+            tableChaude.emplace(std::string_view(p_noeud2->mot), p_noeud2);
+        }
+        if (chaud2) {
+            tableChaude.emplace(std::string_view(p_noeud1->mot), p_noeud1);
+        }
+    }
+
+    /**
+     * \brief Ramasse les noeuds d'un sous-arbre qui ont ete consultes au moins une fois
+     * \param[in] p_root Le sous-arbre
+     * \param[out] p_noeuds Les paires nombre d'acces / noeud
+     * \post L'arbre est inchangé
+     */
+    void Dictionnaire::_noeudsConsultes(NoeudDictionnaire *p_root,
+                                        std::vector<std::pair<unsigned long, NoeudDictionnaire *>> &p_noeuds) const {
+        if (p_root != 0) {
+            unsigned long acces = p_root->acces.load(std::memory_order_relaxed);
+            if (acces > 0) {
+                p_noeuds.push_back(std::make_pair(acces, p_root));
+            }
+            _noeudsConsultes(p_root->gauche, p_noeuds);
+            _noeudsConsultes(p_root->droite, p_noeuds);
+        }
+    }
+
+    /**
+     * \brief Remet a zero les acces d'un sous-arbre
+     * \param[in] p_root Le sous-arbre
+     */
+    void Dictionnaire::_reinitialiserAcces(NoeudDictionnaire *p_root) {
+        if (p_root != 0) {
+            p_root->acces = 0;
+            _reinitialiserAcces(p_root->gauche);
+            _reinitialiserAcces(p_root->droite);
+        }
     }
 
     /**
@@ -237,6 +1070,7 @@ namespace TP3 {
         //Si l'arbre n'est pas vide, hauteur est 1 + hauteur de la plus longue branch du noeud.
         if (p_root != 0) {
             p_root->hauteur = 1 + std::max(_hauteur(p_root->gauche), _hauteur(p_root->droite));
+            p_root->taille = 1 + _taille(p_root->gauche) + _taille(p_root->droite);
         }
     }
 
@@ -256,6 +1090,75 @@ namespace TP3 {
         return p_root->hauteur;
     }
 
+    /**
+     * \brief Retourne le nombre de noeuds d'un sous-arbre
+     * \param[in] p_root Un sous-arbre
+     * \return Le nombre de noeuds, 0 pour un arbre vide
+     * \post L'arbre est inchangé
+     */
+    std::size_t Dictionnaire::_taille(NoeudDictionnaire *p_root) const
+    {
+        if (p_root == 0) {
+            return 0;
+        }
+        return p_root->taille;
+    }
+
+    /**
+     * \brief Compte les mots plus petits que le mot donne, ou egaux si inclus est vrai
+     * \param[in] p_root Le sous-arbre
+     * \param[in] mot Le mot de reference
+     * \param[in] inclus Vrai pour compter aussi le mot lui-meme
+     * \return Le nombre de mots du sous-arbre qui precedent le mot
+     * \post L'arbre est inchangé
+     */
+    std::size_t Dictionnaire::_rang(NoeudDictionnaire *p_root, std::string_view mot, bool inclus) const
+    {
+        std::size_t rang = 0;
+        //Descente iterative: chaque fois qu'on va a droite, le sous-arbre gauche et le noeud precedent le mot
+        while (p_root != 0) {
+            if (p_root->mot < mot || (inclus && p_root->mot == mot)) {
+                rang += _taille(p_root->gauche) + 1;
+                p_root = p_root->droite;
+            } else {
+                p_root = p_root->gauche;
+            }
+        }
+        return rang;
+    }
+
+    /**
+     * \brief Ajoute a la liste les mots d'un sous-arbre, en ordre, a partir d'un rang
+     * \param[in] p_root Le sous-arbre
+     * \param[in] debut Le rang (dans le sous-arbre) du premier mot a ajouter
+     * \param[in] nbMots Le nombre de mots a ajouter
+     * \param[in,out] p_mots La liste des mots
+     * \post L'arbre est inchangé
+     */
+    void Dictionnaire::_lister(NoeudDictionnaire *p_root, std::size_t debut, std::size_t nbMots,
+                               std::vector<std::string> &p_mots) const
+    {
+        if (p_root == 0 || nbMots == 0) {
+            return;
+        }
+        std::size_t tailleGauche = _taille(p_root->gauche);
+        //On ne descend a gauche que si la page y commence
+        if (debut < tailleGauche) {
+            std::size_t nbGauche = std::min(nbMots, tailleGauche - debut);
+            _lister(p_root->gauche, debut, nbGauche, p_mots);
+            nbMots -= nbGauche;
+            debut = tailleGauche;
+        }
+        if (nbMots > 0 && debut == tailleGauche) {
+            p_mots.push_back(p_root->mot);
+            nbMots--;
+            debut++;
+        }
+        if (nbMots > 0) {
+            _lister(p_root->droite, debut - tailleGauche - 1, nbMots, p_mots);
+        }
+    }
+
     /**
      * \brief Effectuer la transformation zig-zig gauche
      * \param[in] p_noeudCritique Le noeud critique du zig-zig
@@ -329,6 +1232,8 @@ namespace TP3 {
                                + std::max(_hauteur(p_root->gauche),
                                           _hauteur(p_root->droite));//on va chercher la hauteur du noeud le plus haut
                                                                         //et on l'ajoute au 1.
+            //La taille du sous-arbre se met a jour au meme moment que la hauteur
+            p_root->taille = 1 + _taille(p_root->gauche) + _taille(p_root->droite);
         }
     }
 
@@ -430,45 +1335,98 @@ namespace TP3 {
      * \param[in] motTraduit La traduction a ajouter
      * \post L'élément et sa traduction sont ajoutés
      */
-    void Dictionnaire::_insererAVL(NoeudDictionnaire * &p_root,const std::string &motOriginal,const std::string &motTraduit)
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_insererAVL(NoeudDictionnaire * &p_root, std::string &&motOriginal, std::string &&motTraduit)
     {
         //Si on a atteint une feuille
         if (p_root == 0) {
-            p_root = new NoeudDictionnaire(motOriginal, motTraduit);
+            p_root = new NoeudDictionnaire(std::move(motOriginal), std::move(motTraduit));
             cpt++;
-            return;
-        }//Si le mot est plus grant que le mot du noeud acutel, on reappel la fonction avec le noeud de droite
-        else if (p_root->mot < motOriginal) {
-            _insererAVL(p_root->droite, motOriginal, motTraduit);
+            return p_root;
+        }
+        //Les rotations deplacent les liens, pas les noeuds: le nouveau noeud reste valide
+        NoeudDictionnaire *nouveau;
+        //Si le mot est plus grant que le mot du noeud acutel, on reappel la fonction avec le noeud de droite
+        if (p_root->mot < motOriginal) {
+            nouveau = _insererAVL(p_root->droite, std::move(motOriginal), std::move(motTraduit));
         }//Sinon avec le noeud de gauche
         else {
-            _insererAVL(p_root->gauche, motOriginal, motTraduit);
+            nouveau = _insererAVL(p_root->gauche, std::move(motOriginal), std::move(motTraduit));
         }
 
         _miseAJourHauteurNoeud(p_root);
         _balancerUnNoeud(p_root);
+        return nouveau;
     }
 
     /**
-     * \brief Fonction récursive pour trouver un mot dans le dictionnaire et le retourner
-     * \param[in] p_root Le sous arbre actuel
-     * \param[in] mot L'élément à trouver
-     * \return L'élément trouve
+     * \brief Retire un mot de l'arbre, de l'index inverse et du filtre; le verrou d'ecriture doit etre pris
+     * \param[in] motASupprimer une copie du mot, qui reste valide pendant que la suppression deplace les noeuds
+     * \param[in] noeudMot le noeud du mot
+     * \post Le mot et ses traductions sont enleves
      */
-    Dictionnaire::NoeudDictionnaire *& Dictionnaire::_trouverMot(NoeudDictionnaire *&p_root, const std::string &mot) const
-    {
-        //Condition d'arret
-        if (p_root->mot == mot) {
-            return p_root;
+    void Dictionnaire::_retirerMot(const std::string &motASupprimer, NoeudDictionnaire *noeudMot) {
+        for (const std::string &traduction : noeudMot->traductions) {
+            _retirerIndexInverse(motASupprimer, traduction);
         }
-        //Cas mot plus petit que mot racine. Debut recursivite.
-        if (p_root->mot > mot) {
-            return _trouverMot(p_root->gauche, mot);
+        filtre.retire(motASupprimer);
+        //Les autres mots chauds que la suppression deplace sont remis a jour par _echangerContenu
+        tableChaude.erase(motASupprimer);
+        generation++;
+        _supprimerAVL(racine, motASupprimer);
+    }
+
+    /**
+     * \brief Retire une traduction d'un mot, et le mot lui-meme s'il n'en a plus; le verrou d'ecriture doit etre pris
+     * \param[in] motASupprimer une copie du mot
+     * \param[in] noeudMot le noeud du mot
+     * \param[in] traduction la traduction a retirer, parmi celles du noeud
+     * \post La traduction est enlevee
+     */
+    void Dictionnaire::_retirerTraduction(const std::string &motASupprimer, NoeudDictionnaire *noeudMot,
+                                          std::vector<std::string>::iterator traduction) {
+        _retirerIndexInverse(motASupprimer, *traduction);
+        noeudMot->traductions.erase(traduction);
+        //Un mot sans traduction n'a plus sa place dans le dictionnaire
+        if (noeudMot->traductions.empty()){
+            _retirerMot(motASupprimer, noeudMot);
         }
-            //Cas mot plus grand que mot racine. Debut recursivite.
-        else {
-            return _trouverMot(p_root->droite, mot);
+    }
+
+    /**
+     * \brief Remplace toutes les traductions d'un mot; le verrou d'ecriture doit etre pris
+     * \param[in] mot le mot
+     * \param[in] noeudMot le noeud du mot
+     * \param[in] traductions les nouvelles traductions, non vides, deplacees dans le noeud
+     * \param[in,out] p_ajoutees augmente du nombre de traductions ajoutees
+     * \param[in,out] p_retirees augmente du nombre de traductions retirees
+     * \post Le mot a exactement les traductions donnees, dans le meme ordre
+     */
+    void Dictionnaire::_remplacerTraductions(const std::string &mot, NoeudDictionnaire *noeudMot,
+                                             std::vector<std::string> &&traductions,
+                                             std::size_t &p_ajoutees, std::size_t &p_retirees) {
+        //Les traductions peuvent se repeter: l'index et la trace suivent la difference des multi-ensembles
+        std::vector<std::string_view> anciennes(noeudMot->traductions.begin(), noeudMot->traductions.end());
+        std::vector<std::string_view> nouvelles(traductions.begin(), traductions.end());
+        std::sort(anciennes.begin(), anciennes.end());
+        std::sort(nouvelles.begin(), nouvelles.end());
+        std::vector<std::string_view> ajouts, retraits;
+        std::set_difference(nouvelles.begin(), nouvelles.end(), anciennes.begin(), anciennes.end(),
+                            std::back_inserter(ajouts));
+        std::set_difference(anciennes.begin(), anciennes.end(), nouvelles.begin(), nouvelles.end(),
+                            std::back_inserter(retraits));
+        //Les ajouts sont enregistres avant les retraits, pour qu'en rejouant la trace le mot ne disparaisse pas
+        for (std::string_view traduction : ajouts) {
+            _enregistrer(TRACE_AJOUTE, mot, traduction);
+            _ajouterIndexInverse(mot, traduction);
         }
+        for (std::string_view traduction : retraits) {
+            _enregistrer(TRACE_SUPPRIME_TRADUCTION, mot, traduction);
+            _retirerIndexInverse(mot, traduction);
+        }
+        p_ajoutees += ajouts.size();
+        p_retirees += retraits.size();
+        //Les vues sur les anciennes traductions ne servent plus: on peut remplacer le vecteur
+        noeudMot->traductions = std::move(traductions);
     }
 
     /**
@@ -477,7 +1435,7 @@ namespace TP3 {
      * \param[in] motASupprimer L'élément à enlever
      * \post L'élément est enlevé
      */
-    void Dictionnaire::_supprimerAVL(NoeudDictionnaire *&p_root, const std::string &motASupprimer){
+    void Dictionnaire::_supprimerAVL(NoeudDictionnaire *&p_root, std::string_view motASupprimer){
         // Appels récursifs à gauche et à droite.
         if (p_root->mot < motASupprimer) {
             _supprimerAVL(p_root->droite, motASupprimer);
@@ -496,13 +1454,11 @@ namespace TP3 {
             else if (!_aDeuxfils(p_root)) {
                 // Si on a juste un fils, on interchange et on supprime le fils (récursivement).
                 if (p_root->gauche != 0) {
-                    std::swap(p_root->mot, p_root->gauche->mot);
-                    std::swap(p_root->traductions, p_root->gauche->traductions);
+                    _echangerContenu(p_root, p_root->gauche);
                     _supprimerAVL(p_root->gauche, motASupprimer);
                 }
                 else {
-                    std::swap(p_root->mot, p_root->droite->mot);
-                    std::swap(p_root->traductions, p_root->droite->traductions);
+                    _echangerContenu(p_root, p_root->droite);
                     _supprimerAVL(p_root->droite, motASupprimer);
                 }
             }
@@ -510,8 +1466,7 @@ namespace TP3 {
                 // On a deux fils: cas compliqué.
                 // On interchange la valeur du noeud avec celle de son successeur (minimum dans le sous-arbre de droite).
                 NoeudDictionnaire * minDroite = _min(p_root->droite);
-                std::swap(p_root->mot, minDroite->mot);
-                std::swap(p_root->traductions, minDroite->traductions);
+                _echangerContenu(p_root, minDroite);
 
                 // Puis, on appelle récursivement sur le sous-arbre de droite.
                 _supprimerAVL(p_root->droite, motASupprimer);
@@ -552,26 +1507,142 @@ namespace TP3 {
     /**
      * \brief Methode pour avoir la distance de Levenshtein entre 2 strings
      *        Code source pris ici : https://en.wikibooks.org/wiki/Algorithm_Implementation/Strings/Levenshtein_distance
+     *        Seule la ligne precedente de la matrice est gardee, dans un tampon propre a chaque thread.
      * \param[in] first la premiere string
+     * \param[in] len1 la longueur de la premiere string
      * \param[in] second la deuxieme string
+     * \param[in] len2 la longueur de la deuxieme string
      * \return la distance Levenshtein
      * \post L'arbre est inchangé
      */
-    unsigned int Dictionnaire::_getEditDistance(const std::string &first, const std::string &second) const
+    template<typename Caractere>
+    unsigned int Dictionnaire::_getEditDistance(const Caractere *first, std::size_t len1,
+                                                const Caractere *second, std::size_t len2) const
+    {
+        thread_local std::vector<unsigned int> d;
+        d.resize(len2 + 1);
+        for(unsigned int j = 0; j <= len2; ++j) d[j] = j;
+
+        for(unsigned int i = 1; i <= len1; ++i) {
+            //diagonale est d[i - 1][j - 1], d[j] est encore d[i - 1][j] avant son affectation
+            unsigned int diagonale = d[0];
+            d[0] = i;
+            for(unsigned int j = 1; j <= len2; ++j) {
+                unsigned int haut = d[j];
+                d[j] = std::min({ haut + 1, d[j - 1] + 1, diagonale + (first[i - 1] == second[j - 1] ? 0 : 1) });
+                diagonale = haut;
+            }
+        }
+        return d[len2];
+    }
+
+    /**
+     * \brief Calcule la similitude de deux suites de caracteres
+     * \param[in] mot1 le premier mot
+     * \param[in] longueur1 le nombre de caracteres du premier mot
+     * \param[in] mot2 le deuxieme mot
+     * \param[in] longueur2 le nombre de caracteres du deuxieme mot
+     * \return la similitude entre 0 et 1
+     */
+    template<typename Caractere>
+    double Dictionnaire::_similitude(const Caractere *mot1, std::size_t longueur1,
+                                     const Caractere *mot2, std::size_t longueur2) const
+    {
+        double max_length = std::max(longueur1, longueur2);
+        if (max_length > 0) {
+            return (max_length - _getEditDistance(mot1, longueur1, mot2, longueur2)) / max_length;
+        }
+        return 1.0;
+    }
+
+    /**
+     * \brief Verifie si un mot ne contient que des caracteres ASCII
+     *        Les octets sont combines 8 a la fois: un seul test du bit de poids fort de chaque octet a la fin.
+     * \param[in] mot le mot a verifier
+     * \return true si aucun octet n'a son bit de poids fort
+     */
+    bool Dictionnaire::_estAscii(std::string_view mot) const
+    {
+        std::uint64_t cumul = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= mot.size(); i += 8) {
+            std::uint64_t bloc;
+            std::memcpy(&bloc, mot.data() + i, sizeof(bloc));
+            cumul |= bloc;
+        }
+        for (; i < mot.size(); i++) {
+            cumul |= static_cast<unsigned char>(mot[i]);
+        }
+        return (cumul & 0x8080808080808080ull) == 0;
+    }
+
+    /**
+     * \brief Decode un mot UTF-8 en points de code
+     *        Un octet qui ne commence pas une sequence valide (tronquee, trop longue ou hors limites) donne
+     *        un point de code propre a cet octet, de 0xDC80 a 0xDCFF, qu'aucune sequence valide ne produit.
+     * \param[in] mot le mot en UTF-8
+     * \param[out] points les points de code du mot
+     */
+    void Dictionnaire::_decoderUtf8(std::string_view mot, std::vector<char32_t> &points) const
     {
-        const std::size_t len1 = first.size(), len2 = second.size();
-        std::vector<std::vector<unsigned int>> d(len1 + 1, std::vector<unsigned int>(len2 + 1));
+        points.clear();
+        std::size_t i = 0;
+        while (i < mot.size()) {
+            unsigned char octet = static_cast<unsigned char>(mot[i]);
+            std::size_t nbSuite = 0;
+            char32_t point = 0, minimum = 0;
+            if (octet < 0x80) {
+                points.push_back(octet);
+                i++;
+                continue;
+            } else if ((octet & 0xE0) == 0xC0) {
+                nbSuite = 1;
+                point = octet & 0x1F;
+                minimum = 0x80;
+            } else if ((octet & 0xF0) == 0xE0) {
+                nbSuite = 2;
+                point = octet & 0x0F;
+                minimum = 0x800;
+            } else if ((octet & 0xF8) == 0xF0) {
+                nbSuite = 3;
+                point = octet & 0x07;
+                minimum = 0x10000;
+            }
 
-        d[0][0] = 0;
-        for(unsigned int i = 1; i <= len1; ++i) d[i][0] = i;
-        for(unsigned int i = 1; i <= len2; ++i) d[0][i] = i;
+            bool valide = nbSuite > 0;
+            for (std::size_t k = 1; valide && k <= nbSuite; k++) {
+                if (i + k >= mot.size() || (static_cast<unsigned char>(mot[i + k]) & 0xC0) != 0x80) {
+                    valide = false;
+                } else {
+                    point = (point << 6) | (static_cast<unsigned char>(mot[i + k]) & 0x3F);
+                }
+            }
+            //Formes trop longues, demi-codets UTF-16 et valeurs au-dela de Unicode sont invalides
+            if (valide && point >= minimum && point <= 0x10FFFF && (point < 0xD800 || point > 0xDFFF)) {
+                points.push_back(point);
+                i += nbSuite + 1;
+            } else {
+                points.push_back(0xDC00 + octet);
+                i++;
+            }
+        }
+    }
 
-        for(unsigned int i = 1; i <= len1; ++i)
-            for(unsigned int j = 1; j <= len2; ++j)
-                // note that std::min({arg1, arg2, arg3}) works only in C++11,
-                // for C++98 use std::min(std::min(arg1, arg2), arg3)
-                d[i][j] = std::min({ d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (first[i - 1] == second[j - 1] ? 0 : 1) });
-        return d[len1][len2];
+    /**
+     * \brief Retire les espaces ASCII au debut et a la fin d'une chaine
+     *        Seuls des octets ASCII sont retires: une sequence UTF-8 n'est jamais coupee.
+     * \param[in,out] chaine la chaine a rogner
+     */
+    void Dictionnaire::_rogner(std::string &chaine) const
+    {
+        const char *espaces = " \t\r\n\v\f";
+        std::size_t fin = chaine.find_last_not_of(espaces);
+        if (fin == std::string::npos) {
+            chaine.clear();
+            return;
+        }
+        chaine.erase(fin + 1);
+        chaine.erase(0, chaine.find_first_not_of(espaces));
     }
 
     /**
@@ -582,18 +1653,517 @@ namespace TP3 {
      * \post Le vecteur contient tous les mots qui on au moins 0.5 de similarite avec le mot mal ecrit
      */
     void Dictionnaire::_parcousSuggestion(NoeudDictionnaire *p_root,
-                                          std::vector<std::pair <double, std::string>> &p_vectPair,
-                                          std::string p_motMalEcrit) const
+                                          std::vector<std::pair <double, std::string_view>> &p_vectPair,
+                                          std::string_view p_motMalEcrit) const
     {
         if (p_root != 0) {
             double simi = similitude(p_motMalEcrit, p_root->mot); //T'es ici jai switch les 2 pour tester
             if (simi >= 0.5)
             {
-                p_vectPair.push_back(std::make_pair(simi,p_root->mot));
+                p_vectPair.push_back(std::make_pair(simi, std::string_view(p_root->mot)));
             }
             _parcousSuggestion(p_root->gauche, p_vectPair, p_motMalEcrit);
             _parcousSuggestion(p_root->droite, p_vectPair, p_motMalEcrit);
         }
     }
 
+    /**
+     * \brief Trie les mots similaires par similarite decroissante et garde les premiers
+     * \param[in] p_comparaison les paires similarite / mot trouvees par le parcours
+     * \return au plus 5 suggestions
+     */
+    std::vector<std::string> Dictionnaire::_choisirSuggestions(std::vector<std::pair <double, std::string_view>> &p_comparaison) const
+    {
+        std::vector<std::string> suggestions;
+        sort(p_comparaison.rbegin(), p_comparaison.rend());
+
+        std::size_t i = 0;
+        while (i < p_comparaison.size() and suggestions.size() < LIMITE_SUGGESTIONS){
+            suggestions.emplace_back(p_comparaison[i].second);
+            i++;
+        }
+        return suggestions;
+    }
+
+    /**
+     * \brief Accumule le profil d'un sous-arbre
+     * \param[in] p_root Le sous-arbre
+     * \param[in] p_profondeur Le niveau de p_root (la racine est au niveau 0)
+     * \param[in,out] p_profil Le profil en construction
+     * \param[in,out] p_sommeProfondeurs La somme des comparaisons necessaires pour atteindre chaque noeud
+     * \post L'arbre est inchangé
+     */
+    void Dictionnaire::_profiler(NoeudDictionnaire *p_root, int p_profondeur, ProfilArbre &p_profil,
+                                 std::size_t &p_sommeProfondeurs, unsigned long long &p_sommeComparaisons,
+                                 unsigned long long &p_sommeComparaisonsArbre) const
+    {
+        if (p_root != 0) {
+            //Avec une table chaude, un mot chaud coute une comparaison, les autres une de plus que dans l'arbre
+            unsigned long acces = p_root->acces.load(std::memory_order_relaxed);
+            unsigned long long comparaisons = p_profondeur + 1;
+            if (!tableChaude.empty()) {
+                comparaisons = tableChaude.count(std::string_view(p_root->mot)) ? 1 : comparaisons + 1;
+            }
+            p_profil.nbAcces += acces;
+            p_sommeComparaisons += acces * comparaisons;
+            p_sommeComparaisonsArbre += acces * (unsigned long long)(p_profondeur + 1);
+
+            p_profil.nbNoeuds++;
+            p_sommeProfondeurs += p_profondeur + 1;
+            p_profil.profondeurMax = std::max(p_profil.profondeurMax, p_profondeur + 1);
+            if (p_profil.noeudsParNiveau.size() <= std::size_t(p_profondeur)) {
+                p_profil.noeudsParNiveau.resize(p_profondeur + 1, 0);
+            }
+            p_profil.noeudsParNiveau[p_profondeur]++;
+            p_profil.equilibres[_hauteur(p_root->gauche) - _hauteur(p_root->droite)]++;
+
+            p_profil.octetsNoeuds += sizeof(NoeudDictionnaire);
+            p_profil.octetsMots += _octetsChaine(p_root->mot);
+            p_profil.octetsTraductions += p_root->traductions.capacity() * sizeof(std::string);
+            for (const std::string &traduction : p_root->traductions) {
+                p_profil.octetsTraductions += _octetsChaine(traduction);
+            }
+
+            _profiler(p_root->gauche, p_profondeur + 1, p_profil, p_sommeProfondeurs,
+                      p_sommeComparaisons, p_sommeComparaisonsArbre);
+            _profiler(p_root->droite, p_profondeur + 1, p_profil, p_sommeProfondeurs,
+                      p_sommeComparaisons, p_sommeComparaisonsArbre);
+        }
+    }
+
+    /**
+     * \brief Retourne la memoire allouee par une chaine en dehors de l'objet lui-meme
+     * \param[in] chaine La chaine
+     * \return 0 pour une chaine courte, stockee dans l'objet; sa capacite et le zero final sinon
+     */
+    std::size_t Dictionnaire::_octetsChaine(const std::string &chaine) const
+    {
+        static const std::size_t capaciteInterne = std::string().capacity();
+        return chaine.capacity() > capaciteInterne ? chaine.capacity() + 1 : 0;
+    }
+
+    /**
+     * \brief Joint deux arbres AVL et un noeud du milieu
+     *        On descend le long du bord de l'arbre le plus haut jusqu'a une hauteur compatible,
+     *        puis on reequilibre en remontant comme pour une insertion.
+     * \param[in] p_gauche Un arbre dont tous les mots precedent celui de p_milieu
+     * \param[in] p_milieu Un noeud seul
+     * \param[in] p_droite Un arbre dont tous les mots suivent celui de p_milieu
+     * \return La racine de l'arbre joint
+     */
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_joindre(NoeudDictionnaire *p_gauche, NoeudDictionnaire *p_milieu,
+                                                           NoeudDictionnaire *p_droite)
+    {
+        if (_hauteur(p_gauche) > _hauteur(p_droite) + 1) {
+            p_gauche->droite = _joindre(p_gauche->droite, p_milieu, p_droite);
+            _miseAJourHauteurNoeud(p_gauche);
+            _balancerUnNoeud(p_gauche);
+            return p_gauche;
+        }
+        if (_hauteur(p_droite) > _hauteur(p_gauche) + 1) {
+            p_droite->gauche = _joindre(p_gauche, p_milieu, p_droite->gauche);
+            _miseAJourHauteurNoeud(p_droite);
+            _balancerUnNoeud(p_droite);
+            return p_droite;
+        }
+        //Hauteurs compatibles: le noeud du milieu devient la racine
+        p_milieu->gauche = p_gauche;
+        p_milieu->droite = p_droite;
+        _miseAJourHauteurNoeud(p_milieu);
+        return p_milieu;
+    }
+
+    /**
+     * \brief Joint deux arbres AVL sans noeud du milieu
+     * \param[in] p_gauche Un arbre dont tous les mots precedent ceux de p_droite
+     * \param[in] p_droite Un arbre
+     * \return La racine de l'arbre joint
+     */
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_joindreSansMilieu(NoeudDictionnaire *p_gauche,
+                                                                     NoeudDictionnaire *p_droite)
+    {
+        if (p_gauche == 0) {
+            return p_droite;
+        }
+        if (p_droite == 0) {
+            return p_gauche;
+        }
+        NoeudDictionnaire *dernier;
+        NoeudDictionnaire *reste = _separerDernier(p_gauche, dernier);
+        return _joindre(reste, dernier, p_droite);
+    }
+
+    /**
+     * \brief Retire le plus grand noeud d'un arbre
+     * \param[in] p_root Un arbre non vide
+     * \param[out] p_dernier Le noeud retire, sans enfants
+     * \return La racine de l'arbre sans ce noeud
+     */
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_separerDernier(NoeudDictionnaire *p_root,
+                                                                  NoeudDictionnaire *&p_dernier)
+    {
+        if (p_root->droite == 0) {
+            NoeudDictionnaire *reste = p_root->gauche;
+            p_root->gauche = 0;
+            _miseAJourHauteurNoeud(p_root);
+            p_dernier = p_root;
+            return reste;
+        }
+        NoeudDictionnaire *resteDroite = _separerDernier(p_root->droite, p_dernier);
+        return _joindre(p_root->gauche, p_root, resteDroite);
+    }
+
+    /**
+     * \brief Separe un arbre autour d'un mot
+     * \param[in] p_root L'arbre a separer, qui n'existe plus apres l'appel
+     * \param[in] mot Le mot de separation
+     * \param[out] p_gauche Les mots plus petits
+     * \param[out] p_trouve Le noeud du mot, sans enfants, ou 0 s'il n'y est pas
+     * \param[out] p_droite Les mots plus grands
+     */
+    void Dictionnaire::_separer(NoeudDictionnaire *p_root, std::string_view mot, NoeudDictionnaire *&p_gauche,
+                                NoeudDictionnaire *&p_trouve, NoeudDictionnaire *&p_droite)
+    {
+        if (p_root == 0) {
+            p_gauche = p_trouve = p_droite = 0;
+        } else if (p_root->mot == mot) {
+            p_gauche = p_root->gauche;
+            p_droite = p_root->droite;
+            p_root->gauche = p_root->droite = 0;
+            _miseAJourHauteurNoeud(p_root);
+            p_trouve = p_root;
+        } else if (p_root->mot > mot) {
+            NoeudDictionnaire *droiteDuGauche;
+            _separer(p_root->gauche, mot, p_gauche, p_trouve, droiteDuGauche);
+            p_droite = _joindre(droiteDuGauche, p_root, p_root->droite);
+        } else {
+            NoeudDictionnaire *gaucheDuDroite;
+            _separer(p_root->droite, mot, gaucheDuDroite, p_trouve, p_droite);
+            p_gauche = _joindre(p_root->gauche, p_root, gaucheDuDroite);
+        }
+    }
+
+    /**
+     * \brief Union de deux arbres; les noeuds de p_arbre2 sont integres ou liberes
+     * \param[in] p_arbre1 Le premier arbre, dont on garde les noeuds
+     * \param[in] p_arbre2 Le deuxieme arbre
+     * \param[in] p_niveauxParalleles Le nombre de niveaux de recursion qui peuvent encore lancer une tache
+     * \param[out] p_ajoutes Recoit les noeuds de p_arbre2 dont le mot n'etait pas dans p_arbre1
+     * \return La racine de l'union
+     */
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_unir(NoeudDictionnaire *p_arbre1, NoeudDictionnaire *p_arbre2,
+                                                        int p_niveauxParalleles, std::vector<NoeudDictionnaire *> &p_ajoutes)
+    {
+        if (p_arbre1 == 0) {
+            _listerNoeuds(p_arbre2, p_ajoutes);
+            return p_arbre2;
+        }
+        if (p_arbre2 == 0) {
+            return p_arbre1;
+        }
+        bool parallele = p_niveauxParalleles > 0 && _taille(p_arbre1) + _taille(p_arbre2) > SEUIL_PARALLELE;
+
+        NoeudDictionnaire *gauche2, *commun, *droite2, *gauche, *droite;
+        _separer(p_arbre2, p_arbre1->mot, gauche2, commun, droite2);
+        if (parallele) {
+            //Chaque tache a sa propre liste, pour ne pas partager de vecteur entre threads
+            std::vector<NoeudDictionnaire *> ajoutesGauche;
+            std::future<NoeudDictionnaire *> tacheGauche;
+            try {
+                tacheGauche = std::async(std::launch::async, &Dictionnaire::_unir, this, p_arbre1->gauche, gauche2,
+                                         p_niveauxParalleles - 1, std::ref(ajoutesGauche));
+            } catch (const std::system_error &) {
+                //Aucun thread n'a pu etre lance: les arbres sont deja separes, on fait donc la moitie gauche ici
+            }
+            droite = _unir(p_arbre1->droite, droite2, p_niveauxParalleles - 1, p_ajoutes);
+            gauche = tacheGauche.valid() ? tacheGauche.get() : _unir(p_arbre1->gauche, gauche2, 0, ajoutesGauche);
+            p_ajoutes.insert(p_ajoutes.end(), ajoutesGauche.begin(), ajoutesGauche.end());
+        } else {
+            gauche = _unir(p_arbre1->gauche, gauche2, 0, p_ajoutes);
+            droite = _unir(p_arbre1->droite, droite2, 0, p_ajoutes);
+        }
+        if (commun != 0) {
+            _fusionnerTraductions(p_arbre1, commun);
+            delete commun;
+        }
+        return _joindre(gauche, p_arbre1, droite);
+    }
+
+    /**
+     * \brief Difference de deux arbres; les noeuds de p_arbre1 qui sont dans p_arbre2 sont detaches
+     * \param[in] p_arbre1 L'arbre dont on retire des mots
+     * \param[in] p_arbre2 Les mots a retirer, qui n'est pas modifie
+     * \param[in] p_niveauxParalleles Le nombre de niveaux de recursion qui peuvent encore lancer une tache
+     * \param[out] p_retires Recoit les noeuds detaches, que l'appelant doit liberer
+     * \return La racine de la difference
+     */
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_retrancher(NoeudDictionnaire *p_arbre1, NoeudDictionnaire *p_arbre2,
+                                                              int p_niveauxParalleles,
+                                                              std::vector<NoeudDictionnaire *> &p_retires)
+    {
+        if (p_arbre1 == 0 || p_arbre2 == 0) {
+            return p_arbre1;
+        }
+        bool parallele = p_niveauxParalleles > 0 && _taille(p_arbre1) + _taille(p_arbre2) > SEUIL_PARALLELE;
+
+        NoeudDictionnaire *gauche1, *commun, *droite1, *gauche, *droite;
+        _separer(p_arbre1, p_arbre2->mot, gauche1, commun, droite1);
+        if (parallele) {
+            std::vector<NoeudDictionnaire *> retiresGauche;
+            std::future<NoeudDictionnaire *> tacheGauche;
+            try {
+                tacheGauche = std::async(std::launch::async, &Dictionnaire::_retrancher, this, gauche1, p_arbre2->gauche,
+                                         p_niveauxParalleles - 1, std::ref(retiresGauche));
+            } catch (const std::system_error &) {
+                //Comme pour _unir: sans thread, la moitie gauche est faite ici
+            }
+            droite = _retrancher(droite1, p_arbre2->droite, p_niveauxParalleles - 1, p_retires);
+            gauche = tacheGauche.valid() ? tacheGauche.get() : _retrancher(gauche1, p_arbre2->gauche, 0, retiresGauche);
+            p_retires.insert(p_retires.end(), retiresGauche.begin(), retiresGauche.end());
+        } else {
+            gauche = _retrancher(gauche1, p_arbre2->gauche, 0, p_retires);
+            droite = _retrancher(droite1, p_arbre2->droite, 0, p_retires);
+        }
+        if (commun != 0) {
+            p_retires.push_back(commun);
+        }
+        return _joindreSansMilieu(gauche, droite);
+    }
+
+    /**
+     * \brief Intersection de deux arbres; les noeuds de p_arbre1 absents de p_arbre2 sont liberes
+     * \param[in] p_arbre1 L'arbre dont on garde les noeuds
+     * \param[in] p_arbre2 Les mots a garder, qui n'est pas modifie
+     * \param[in] p_niveauxParalleles Le nombre de niveaux de recursion qui peuvent encore lancer une tache
+     * \return La racine de l'intersection
+     */
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_intersecter(NoeudDictionnaire *p_arbre1, NoeudDictionnaire *p_arbre2,
+                                                               int p_niveauxParalleles)
+    {
+        if (p_arbre1 == 0) {
+            return 0;
+        }
+        if (p_arbre2 == 0) {
+            _detruire(p_arbre1);
+            return 0;
+        }
+        bool parallele = p_niveauxParalleles > 0 && _taille(p_arbre1) + _taille(p_arbre2) > SEUIL_PARALLELE;
+
+        NoeudDictionnaire *gauche1, *commun, *droite1, *gauche, *droite;
+        _separer(p_arbre1, p_arbre2->mot, gauche1, commun, droite1);
+        if (parallele) {
+            std::future<NoeudDictionnaire *> tacheGauche;
+            try {
+                tacheGauche = std::async(std::launch::async, &Dictionnaire::_intersecter, this, gauche1, p_arbre2->gauche,
+                                         p_niveauxParalleles - 1);
+            } catch (const std::system_error &) {
+                //Comme pour _unir: sans thread, la moitie gauche est faite ici
+            }
+            droite = _intersecter(droite1, p_arbre2->droite, p_niveauxParalleles - 1);
+            gauche = tacheGauche.valid() ? tacheGauche.get() : _intersecter(gauche1, p_arbre2->gauche, 0);
+        } else {
+            gauche = _intersecter(gauche1, p_arbre2->gauche, 0);
+            droite = _intersecter(droite1, p_arbre2->droite, 0);
+        }
+        if (commun == 0) {
+            return _joindreSansMilieu(gauche, droite);
+        }
+        _fusionnerTraductions(commun, p_arbre2);
+        return _joindre(gauche, commun, droite);
+    }
+
+    /**
+     * \brief Ajoute a un noeud les traductions d'un autre noeud du meme mot qu'il n'a pas deja
+     * \param[in] p_destination Le noeud qui recoit les traductions
+     * \param[in] p_source Le noeud dont on copie les traductions
+     */
+    void Dictionnaire::_fusionnerTraductions(NoeudDictionnaire *p_destination, const NoeudDictionnaire *p_source)
+    {
+        std::size_t nbOriginales = p_destination->traductions.size();
+        for (const std::string &traduction : p_source->traductions) {
+            std::vector<std::string>::iterator fin = p_destination->traductions.begin() + nbOriginales;
+            if (std::find(p_destination->traductions.begin(), fin, traduction) == fin) {
+                p_destination->traductions.push_back(traduction);
+            }
+        }
+        p_destination->acces += p_source->acces;
+    }
+
+    /**
+     * \brief Copie un sous-arbre
+     * \param[in] p_root Le sous-arbre a copier
+     * \return La racine de la copie
+     * \post L'arbre est inchangé
+     */
+    Dictionnaire::NoeudDictionnaire *Dictionnaire::_copier(const NoeudDictionnaire *p_root) const
+    {
+        if (p_root == 0) {
+            return 0;
+        }
+        NoeudDictionnaire *copie = new NoeudDictionnaire(std::string(p_root->mot), std::string());
+        copie->traductions = p_root->traductions;
+        copie->hauteur = p_root->hauteur;
+        copie->taille = p_root->taille;
+        copie->acces = p_root->acces.load();
+        copie->gauche = _copier(p_root->gauche);
+        copie->droite = _copier(p_root->droite);
+        return copie;
+    }
+
+    /**
+     * \brief Calcule le nombre de niveaux de recursion a paralleliser
+     * \return Assez de niveaux pour occuper tous les threads permis, plus un pour equilibrer la charge
+     */
+    int Dictionnaire::_niveauxParalleles() const
+    {
+        unsigned int nbCoeurs = nbThreadsEnBloc != 0 ? nbThreadsEnBloc : std::thread::hardware_concurrency();
+        int niveaux = 0;
+        while ((1u << niveaux) < nbCoeurs) {
+            niveaux++;
+        }
+        return nbCoeurs <= 1 ? 0 : niveaux + 1;
+    }
+
+    /**
+     * \brief Ajoute une operation a la trace, si elle est enregistree
+     * \param[in] operation l'operation
+     * \param[in] mot son mot
+     * \param[in] traduction sa traduction, s'il y a lieu
+     * \pre Le verrou est pris (en lecture au moins)
+     */
+    void Dictionnaire::_enregistrer(OperationTrace operation, std::string_view mot, std::string_view traduction) const
+    {
+        if (enregistreur != 0) {
+            enregistreur->enregistre(operation, mot, traduction);
+        }
+    }
+
+    /**
+     * \brief Reconstruit le filtre de Bloom a partir des mots de l'arbre
+     * \param[in] capacite le nombre de mots prevu
+     * \param[in] tauxFauxPositifs le taux de faux positifs vise
+     * \pre Le verrou d'ecriture est pris
+     */
+    void Dictionnaire::_reconstruireFiltre(std::size_t capacite, double tauxFauxPositifs)
+    {
+        filtre = FiltreBloomCompteur(capacite, tauxFauxPositifs);
+        _remplirFiltre(racine);
+    }
+
+    /**
+     * \brief Ajoute au filtre les mots d'un sous-arbre
+     * \param[in] p_root Le sous-arbre
+     */
+    void Dictionnaire::_remplirFiltre(const NoeudDictionnaire *p_root)
+    {
+        if (p_root != 0) {
+            filtre.ajoute(p_root->mot);
+            _remplirFiltre(p_root->gauche);
+            _remplirFiltre(p_root->droite);
+        }
+    }
+
+    /**
+     * \brief Ajoute a une liste tous les noeuds d'un sous-arbre
+     * \param[in] p_root Le sous-arbre
+     * \param[in,out] p_noeuds La liste
+     */
+    void Dictionnaire::_listerNoeuds(NoeudDictionnaire *p_root, std::vector<NoeudDictionnaire *> &p_noeuds) const
+    {
+        if (p_root != 0) {
+            p_noeuds.push_back(p_root);
+            _listerNoeuds(p_root->gauche, p_noeuds);
+            _listerNoeuds(p_root->droite, p_noeuds);
+        }
+    }
+
+    /**
+     * \brief Remet a jour le compteur de mots et les structures annexes apres une operation en bloc
+     * \param[in] p_reconstruireFiltre vrai si l'operation n'a pas tenu le filtre a jour elle-meme
+     * \pre Le verrou d'ecriture est pris
+     */
+    void Dictionnaire::_apresOperationEnBloc(bool p_reconstruireFiltre)
+    {
+        cpt = _taille(racine);
+        generation++;
+        tableChaude.clear();
+        indexInverse.reset();
+        //Le filtre n'est reconstruit, en O(N), que s'il deborde: comme pour ajouteMot, sa capacite double
+        if (p_reconstruireFiltre || filtre.nbElements() > filtre.capacite()) {
+            std::size_t capacite = filtre.capacite();
+            while (capacite < static_cast<std::size_t>(cpt)) {
+                capacite *= 2;
+            }
+            _reconstruireFiltre(capacite, filtre.tauxVise());
+        }
+    }
+
+    /**
+     * \brief Compare le dictionnaire au contenu d'un nouveau fichier, par une seule fusion des deux en ordre
+     * \param[in,out] p_nouveau le contenu du nouveau fichier; les mots deja presents en sont retires
+     * \param[out] p_motsSupprimes les mots absents du nouveau fichier
+     * \param[out] p_remplacements les mots dont les traductions ont change, avec leurs traductions dans l'ordre du fichier
+     * \post L'arbre est inchangé
+     */
+    void Dictionnaire::_parcoursDifferences(std::map<std::string, std::vector<std::string>> &p_nouveau,
+                                            std::vector<std::string> &p_motsSupprimes,
+                                            std::vector<std::pair<std::string, std::vector<std::string>>> &p_remplacements) const
+    {
+        //Parcours en ordre avec une pile, en avancant dans la table en meme temps: O(N + M), sans recherche par mot
+        std::vector<NoeudDictionnaire *> pile;
+        std::map<std::string, std::vector<std::string>>::iterator entree = p_nouveau.begin();
+        NoeudDictionnaire *courant = racine;
+        while (courant != 0 || !pile.empty()) {
+            while (courant != 0) {
+                pile.push_back(courant);
+                courant = courant->gauche;
+            }
+            courant = pile.back();
+            pile.pop_back();
+
+            //Les mots du fichier qui precedent restent dans la table: ce sont des mots nouveaux
+            while (entree != p_nouveau.end() && entree->first < courant->mot) {
+                ++entree;
+            }
+            if (entree == p_nouveau.end() || entree->first != courant->mot) {
+                p_motsSupprimes.push_back(courant->mot);
+            } else {
+                //L'ordre des traductions compte: il est celui du fichier
+                if (entree->second != courant->traductions) {
+                    p_remplacements.emplace_back(courant->mot, std::move(entree->second));
+                }
+                entree = p_nouveau.erase(entree);
+            }
+            courant = courant->droite;
+        }
+    }
+
+    /**
+     * \brief Affiche un resume du profil de l'arbre
+     * \param[in] out Le flux de sortie
+     * \param[in] profil Le profil a afficher
+     * \return Le flux de sortie
+     */
+    std::ostream &operator<<(std::ostream &out, const Dictionnaire::ProfilArbre &profil) {
+        out << "Noeuds: " << profil.nbNoeuds << std::endl;
+        out << "Hauteur: " << profil.hauteur << " (borne AVL: " << profil.hauteurMaxAVL << ")" << std::endl;
+        out << "Comparaisons par recherche: moyenne " << profil.profondeurMoyenne
+            << ", maximum " << profil.profondeurMax << std::endl;
+        out << "Noeuds par niveau:";
+        for (std::size_t nb : profil.noeudsParNiveau) {
+            out << " " << nb;
+        }
+        out << std::endl << "Facteurs d'equilibre:";
+        for (const std::pair<const int, std::size_t> &equilibre : profil.equilibres) {
+            out << " [" << equilibre.first << "] " << equilibre.second;
+        }
+        out << std::endl << "Octets: noeuds " << profil.octetsNoeuds << ", mots " << profil.octetsMots
+            << ", traductions " << profil.octetsTraductions << std::endl;
+        if (profil.nbAcces > 0) {
+            out << "Comparaisons ponderees par " << profil.nbAcces << " acces: " << profil.comparaisonsPonderees
+                << " (arbre seul: " << profil.comparaisonsPondereesArbre << ")" << std::endl;
+        }
+        return out;
+    }
+
 }//Fin du namespace
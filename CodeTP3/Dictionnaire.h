@@ -14,9 +14,29 @@
 #include <iostream>
 #include <fstream> // pour les fichiers
 #include <string>
+#include <string_view>
+#include <span>
 #include <vector>
 #include <queue>
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <shared_mutex>
+#include <future>
+#include <thread>
+#include <iterator>
+#include <stop_token>
+#include <system_error>
+#include "Asynchrone.h"
+#include "FiltreBloomCompteur.h"
+#include "Trace.h"
 
 namespace TP3 {
 
@@ -34,39 +54,224 @@ namespace TP3 {
         //Destructeur.
         ~Dictionnaire();
 
+        //Statistiques produites par un rechargement incrémental du dictionnaire
+        struct StatistiquesRechargement {
+            std::size_t motsAjoutes;            // Mots présents dans le nouveau fichier seulement
+            std::size_t motsSupprimes;          // Mots absents du nouveau fichier
+            std::size_t traductionsAjoutees;    // Traductions ajoutées à des mots déjà présents
+            std::size_t traductionsSupprimees;  // Traductions retirées de mots toujours présents
+            std::size_t motsTouches;            // Mots ajoutés, supprimés ou dont les traductions ont changé
+                                                // (ou seulement l'ordre). Ce sont des mots et non des noeuds:
+                                                // l'équilibrage modifie en plus O(log N) noeuds par mot ajouté ou
+                                                // supprimé, selon la forme de l'arbre plutôt que selon le fichier.
+            double dureeMs;                     // Durée totale du rechargement, en millisecondes
+        };
+
+        //Recharger le dictionnaire à partir d'une nouvelle version du fichier
+        //Seules les différences avec le contenu actuel sont appliquées, mot par mot, de sorte que
+        //les requêtes continuent d'être servies pendant le rechargement.
+        //Le fichier est lu et vérifié en entier avant la première modification.
+        //Après le rechargement, chaque mot a ses traductions dans l'ordre du fichier, comme à la construction.
+        //La lecture et la comparaison, sans verrou d'écriture, sont linéaires dans la taille du fichier (s'il est trié)
+        //et du dictionnaire; seules les modifications, sous le verrou d'écriture, coûtent selon l'ampleur du
+        //changement.
+        //Le fichier doit être ouvert au préalable
+        //Exception	logic_error si le fichier n'est pas ouvert
+        //Exception	runtime_error si la lecture du fichier échoue; le dictionnaire n'est alors pas modifié
+        StatistiquesRechargement recharge(std::ifstream &fichier);
+
         //Ajouter un mot au dictionnaire et l'une de ses traductions en équilibrant l'arbre AVL
         void ajouteMot(const std::string &motOriginal, const std::string &motTraduit);
 
+        //Comme ajouteMot, mais les chaînes sont déplacées dans le noeud plutôt que copiées
+        void ajouteMot(std::string &&motOriginal, std::string &&motTraduit);
+
+        //Comme ajouteMot, mais la traduction est construite sur place à partir des arguments donnés
+        //Le mot original n'est copié que s'il est nouveau.
+        template<typename... Arguments>
+        void ajouteMotEnPlace(std::string_view motOriginal, Arguments &&... argumentsTraduction) {
+            _ajouterEnPlace(motOriginal, std::string(std::forward<Arguments>(argumentsTraduction)...));
+        }
+
         //Supprimer un mot et équilibrer l'arbre AVL
         //Si le mot appartient au dictionnaire, on l'enlève et on équilibre. Sinon, on ne fait rien.
         //Exception	logic_error si l'arbre est vide
         //Exception	logic_error si le mot n'appartient pas au dictionnaire
-        void supprimeMot(const std::string &motOriginal);
+        void supprimeMot(std::string_view motOriginal);
+
+        //Supprimer l'une des traductions d'un mot
+        //Si c'était sa dernière traduction, le mot est supprimé du dictionnaire.
+        //Exception	logic_error si le mot n'appartient pas au dictionnaire
+        //Exception	logic_error si la traduction n'appartient pas au mot
+        void supprimeTraduction(std::string_view motOriginal, std::string_view motTraduit);
 
         //Quantifier la similitude entre 2 mots (dans le dictionnaire ou pas)
         //Ici, 1 représente le fait que les 2 mots sont identiques, 0 représente le fait que les 2 mots sont complètements différents
         //On retourne une valeur entre 0 et 1 quantifiant la similarité entre les 2 mots donnés
         //Vous pouvez utiliser par exemple la distance de Levenshtein, mais ce n'est pas obligatoire !
-        double similitude(const std::string &mot1, const std::string &mot2S) const;
+        //Les mots sont en UTF-8: un caractère accentué compte pour un seul caractère.
+        double similitude(std::string_view mot1, std::string_view mot2S) const;
 
 
         //Suggère des corrections pour le mot motMalEcrit sous forme d'une liste de mots, dans un vector, à partir du dictionnaire
         //S'il y a suffisament de mots, on redonne 5 corrections possibles au mot donné. Sinon, on en donne le plus possible
         //Exception	logic_error si le dictionnaire est vide
-        std::vector<std::string> suggereCorrections(const std::string &motMalEcrit);
+        std::vector<std::string> suggereCorrections(std::string_view motMalEcrit) const;
 
         //Trouver les traductions possibles d'un mot
-        //Si le mot appartient au dictionnaire, on retourne le vecteur des traductions du mot donné.
-        //Sinon, on retourne un vecteur vide
-        std::vector<std::string> traduit(const std::string &mot);
+        //Si le mot appartient au dictionnaire, on retourne une vue sur les traductions du mot donné.
+        //Sinon, on retourne une vue vide
+        //La vue est invalidée par toute modification du dictionnaire: si d'autres threads peuvent le modifier,
+        //utiliser plutôt traduitCopie.
+        std::span<const std::string> traduit(std::string_view mot) const;
+
+        //Comme traduit, mais on retourne une copie des traductions, toujours valide
+        std::vector<std::string> traduitCopie(std::string_view mot) const;
 
         //Vérifier si le mot donné appartient au dictionnaire
         //On retourne true si le mot est dans le dictionnaire. Sinon, on retourne false.
-        bool appartient(const std::string &data);
+        bool appartient(std::string_view data) const;
+
+        //Trouver les mots anglais qui ont le mot français donné parmi leurs traductions
+        //L'index inverse est construit au premier appel, puis tenu à jour par ajouteMot, supprimeMot et supprimeTraduction.
+        //On retourne les mots en ordre alphabétique, sans doublon, ou un vecteur vide si aucun mot ne correspond.
+        std::vector<std::string> traduitInverse(std::string_view motTraduit) const;
+
+        //Retourne le nombre d'octets (approximatif) occupés par l'index inverse, 0 s'il n'a pas encore été construit
+        std::size_t memoireIndexInverse() const;
 
         //Vérifier si le dictionnaire est vide
         bool estVide() const;
 
+        //État du filtre de Bloom qui écarte les mots absents avant de parcourir l'arbre
+        struct StatistiquesFiltre {
+            std::size_t capacite;           // Nombre de mots pour lequel le filtre est dimensionné
+            double tauxVise;                // Taux de faux positifs visé à pleine capacité
+            std::size_t nbMots;             // Nombre de mots dans le filtre
+            unsigned int nbHachages;        // Nombre de compteurs par mot
+            std::size_t octets;             // Mémoire occupée par les compteurs
+            double tauxFauxPositifsEstime;  // Proportion estimée des mots absents qui passent quand même le filtre
+        };
+
+        //Redimensionner le filtre pour la capacité et le taux de faux positifs donnés, puis le reconstruire
+        //Un filtre plus petit tient mieux en cache, mais laisse passer plus de mots absents jusqu'à l'arbre.
+        //Lorsque le dictionnaire dépasse la capacité, elle est doublée automatiquement au même taux.
+        //Exception	logic_error si la capacité est nulle ou si le taux n'est pas entre 0 et 1 exclusivement
+        void configureFiltre(std::size_t capacite, double tauxFauxPositifs);
+
+        //Retourner l'état du filtre de Bloom
+        StatistiquesFiltre statistiquesFiltre() const;
+
+        //Fixer le nombre de threads que peuvent occuper les opérations en bloc
+        //0 (le défaut) pour le nombre de coeurs de la machine, 1 pour les exécuter sans lancer de tâche.
+        void configureParallelisme(unsigned int nbThreads);
+
+        //Enregistrer dans une trace chaque appel à appartient, traduit, traduitCopie, suggereCorrections,
+        //ajouteMot, supprimeMot et supprimeTraduction (et leurs versions asynchrones), avec ses arguments
+        //Passer nullptr pour arrêter. Après le retour, plus aucun appel n'utilise l'ancien enregistreur,
+        //qui peut donc être détruit. Les opérations en bloc ne sont pas enregistrées.
+        void enregistreTrace(EnregistreurTrace *nouvelEnregistreur);
+
+        //Opérations en bloc, basées sur la jonction (join) et la séparation (split) d'arbres AVL
+        //Pour M mots dans l'autre dictionnaire et N dans celui-ci, le travail sur les arbres est en O(m log(n/m + 1)),
+        //où m = min(M, N) et n = max(M, N); s'y ajoute la copie de l'autre dictionnaire, en O(M), et pour intersecte
+        //la libération des mots non gardés, en O(N). Les deux moitiés de chaque appel récursif sont traitées en
+        //parallèle lorsque les arbres sont assez grands (voir configureParallelisme).
+        //L'autre dictionnaire est copié au préalable et n'est pas modifié. L'index inverse et la table chaude sont
+        //remis à zéro (l'index sera reconstruit au prochain traduitInverse).
+        //fusionne et retranche tiennent le filtre de Bloom à jour mot par mot, en O(M); il n'est reconstruit, en O(N),
+        //que s'il faut doubler sa capacité. intersecte et separe le reconstruisent toujours, en O(N).
+
+        //Ajouter tous les mots de l'autre dictionnaire (union)
+        //Pour un mot présent dans les deux, on ajoute les traductions qu'il n'a pas déjà.
+        void fusionne(const Dictionnaire &autre);
+
+        //Supprimer tous les mots qui sont dans l'autre dictionnaire (différence)
+        void retranche(const Dictionnaire &autre);
+
+        //Garder seulement les mots qui sont aussi dans l'autre dictionnaire (intersection)
+        //Les traductions des mots gardés sont fusionnées comme pour fusionne.
+        void intersecte(const Dictionnaire &autre);
+
+        //Déplacer dans superieurs tous les mots plus grands ou égaux au mot donné
+        //La séparation des arbres est en O(log N), mais la reconstruction des filtres des deux dictionnaires est en O(N).
+        //Exception	logic_error si superieurs n'est pas vide ou est ce dictionnaire
+        void separe(std::string_view mot, Dictionnaire &superieurs);
+
+        //Retourner le nombre de mots du dictionnaire strictement plus petits que le mot donné (dans le dictionnaire ou pas)
+        //En O(log N)
+        std::size_t rang(std::string_view mot) const;
+
+        //Retourner le k-ième mot en ordre alphabétique (k commence à 0), en O(log N)
+        //La vue est invalidée par toute modification du dictionnaire
+        //Exception	out_of_range si k est plus grand ou égal au nombre de mots
+        std::string_view selectionne(std::size_t k) const;
+
+        //Compter les mots compris entre motMin et motMax inclusivement, en O(log N)
+        std::size_t compte(std::string_view motMin, std::string_view motMax) const;
+
+        //Retourner au plus nbMots mots en ordre alphabétique, à partir du mot de rang debut
+        //En O(log N + nbMots), pour paginer une liste des mots
+        std::vector<std::string> page(std::size_t debut, std::size_t nbMots) const;
+
+        //Profil de la structure et de la mémoire de l'arbre
+        struct ProfilArbre {
+            std::size_t nbNoeuds;                       // Nombre de mots dans l'arbre
+            int hauteur;                                // Hauteur de l'arbre (-1 s'il est vide, 0 pour une feuille seule)
+            double hauteurMaxAVL;                       // Borne théorique d'un arbre AVL: 1.44 log2(n + 2) - 1.328
+            double profondeurMoyenne;                   // Nombre moyen de comparaisons pour trouver un mot présent
+            int profondeurMax;                          // Nombre de comparaisons pour le mot le plus profond
+            std::vector<std::size_t> noeudsParNiveau;   // noeudsParNiveau[i]: nombre de noeuds au niveau i (racine = 0)
+            std::map<int, std::size_t> equilibres;      // Nombre de noeuds par facteur d'équilibre (gauche - droite)
+            std::size_t octetsNoeuds;                   // Mémoire des noeuds eux-mêmes
+            std::size_t octetsMots;                     // Mémoire allouée pour les mots (hors noeuds)
+            std::size_t octetsTraductions;              // Mémoire allouée pour les vecteurs de traductions et leurs chaînes
+            unsigned long long nbAcces;                 // Nombre d'accès comptés (voir activeComptageAcces)
+            double comparaisonsPonderees;               // Comparaisons par recherche, pondérées par les accès, table chaude comprise
+            double comparaisonsPondereesArbre;          // La même moyenne si on cherchait seulement dans l'arbre
+        };
+
+        //Calculer le profil de l'arbre en un seul parcours, sans rien afficher
+        ProfilArbre profil() const;
+
+        //Activer ou désactiver le comptage des accès par mot dans appartient, traduit et traduitCopie
+        void activeComptageAcces(bool actif);
+
+        //Compter les accès à partir d'un corpus d'entraînement (mots séparés par des espaces)
+        //Les mots du corpus absents du dictionnaire sont ignorés
+        void entraineAcces(std::istream &corpus);
+
+        //Remettre à zéro le compte des accès de tous les mots
+        void reinitialiseAcces();
+
+        //Placer les nbMotsChauds mots les plus consultés dans une table de hachage consultée avant l'arbre
+        //Les mots fréquents (loi de Zipf) sont alors trouvés sans descendre dans l'arbre.
+        //Un mot supprimé quitte la table; les autres y restent. Les opérations en bloc vident la table: il faut
+        //alors rappeler optimiseAcces.
+        void optimiseAcces(std::size_t nbMotsChauds = 256);
+
+        //Retourne le nombre de mots dans la table chaude
+        std::size_t nbMotsChauds() const;
+
+        //Versions asynchrones (coroutines C++20) de appartient et traduit
+        //Ces recherches exactes se terminent immédiatement, sur le thread de l'appelant
+        //La tâche est terminée au retour: le mot n'a donc pas à survivre à l'appel.
+        Tache<bool> appartientAsync(std::string_view mot);
+        Tache<std::vector<std::string>> traduitAsync(std::string_view mot);
+
+        //Version asynchrone de suggereCorrections
+        //Le parcours est fait sur un thread de l'exécuteur, par tranches de noeuds. Entre deux tranches, la coroutine
+        //cède sa place aux autres tâches de l'exécuteur. Le parcours est en ordre alphabétique: si des mots sont ajoutés ou
+        //supprimés entre deux tranches, il reprend après le dernier mot examiné plutôt que de recommencer.
+        //Détruire la tâche avant la fin arrête le parcours à la tranche suivante, comme une annulation.
+        //Le destructeur du dictionnaire arrête de même les parcours en cours, commencés ou abandonnés, et attend
+        //qu'ils aient atteint leur prochaine tranche: l'exécuteur doit donc continuer de les reprendre jusque-là
+        //(ce que fait aussi son destructeur).
+        //Exception	system_error (errc::operation_canceled) si l'annulation est demandée avant la fin du parcours,
+        //ou si le dictionnaire est détruit pendant le parcours
+        Tache<std::vector<std::string>> suggereCorrectionsAsync(std::string motMalEcrit, ExecuteurFond &executeur,
+                                                                std::stop_token annulation = std::stop_token());
+
         //Affiche à l'écran l'arbre niveau par niveau de façon à voir si l'arbre est bien balancé.
         //Ne touchez pas s.v.p. à cette méthode !
         friend std::ostream &operator<<(std::ostream &out, const Dictionnaire &d) {
@@ -121,11 +326,15 @@ namespace TP3 {
 
             int hauteur;                            // La hauteur de ce noeud (afin de maintenir l'équilibre de l'arbre AVL)
 
+            std::size_t taille;                     // Le nombre de noeuds du sous-arbre (pour rang, selectionne et compte)
+
+            mutable std::atomic<unsigned long> acces; // Nombre d'accès comptés, incrémenté sous verrou de lecture
+
             // Vous pouvez ajouter ici un contructeur de NoeudDictionnaire
-            NoeudDictionnaire(const std::string &motOriginal, const std::string &motTraduit):
-            mot(motOriginal), gauche(0), droite(0), traductions(0)
+            NoeudDictionnaire(std::string &&motOriginal, std::string &&motTraduit):
+            mot(std::move(motOriginal)), traductions(0), gauche(0), droite(0), hauteur(0), taille(1), acces(0)
             {
-                traductions.push_back(motTraduit);
+                traductions.push_back(std::move(motTraduit));
             }
         };
 
@@ -133,13 +342,73 @@ namespace TP3 {
 
         int cpt;                        // Le nombre de mots dans le dictionnaire
 
+        mutable std::shared_mutex verrou; // Lecteurs concurrents, un seul écrivain à la fois
+
+        unsigned long generation;       // Incrémenté à chaque ajout ou suppression de noeud (sous verrou d'écriture)
+
+        unsigned int nbThreadsEnBloc;   // Threads des opérations en bloc, 0 pour le nombre de coeurs (sous verrou)
+
+        // Parcours de suggereCorrectionsAsync en cours, que le destructeur attend après leur avoir demandé d'arrêter
+        std::size_t nbParcours;         // Protégé par verrouParcours
+        std::mutex verrouParcours;
+        std::condition_variable finParcours;
+        std::stop_source arretParcours;
+
+        // Hachage qui permet de chercher dans une table indexée par std::string avec un std::string_view
+        struct HachageTransparent {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view mot) const { return std::hash<std::string_view>()(mot); }
+        };
+
+        typedef std::unordered_map<std::string, std::vector<std::string>, HachageTransparent, std::equal_to<>> IndexInverse;
+
+        // Index inverse: pour chaque traduction, les mots anglais qui la donnent (une entrée par occurrence).
+        // Nul tant que traduitInverse n'a pas été appelé, pour ne rien coûter aux autres utilisateurs.
+        mutable std::unique_ptr<IndexInverse> indexInverse;
+
+        std::atomic<bool> comptageAcces;  // Vrai si les recherches comptent les accès
+
+        // Table des mots les plus consultés, vers leur noeud. Les clés sont des vues sur les mots des noeuds.
+        std::unordered_map<std::string_view, NoeudDictionnaire *, HachageTransparent, std::equal_to<>> tableChaude;
+
+        // Filtre de Bloom sur tous les mots de l'arbre, modifié sous le verrou d'écriture
+        FiltreBloomCompteur filtre;
+
+        // Enregistreur des opérations, nul par défaut. Lu sous le verrou, changé sous le verrou d'écriture.
+        EnregistreurTrace *enregistreur;
+
         //Vous pouvez ajouter autant de méthodes privées que vous voulez
 
+        //Fonction qui extrait le mot anglais et sa traduction d'une ligne du fichier
+        //Retourne false si la ligne est une ligne d'en-tête ou n'a pas de tabulation
+        bool _analyserLigne(const std::string &ligneDico, std::string &motAnglais, std::string &motTraduit) const;
+        //Fonction pour ajouter les traductions d'un sous-arbre à l'index inverse
+        void _construireIndexInverse(NoeudDictionnaire *p_root) const;
+        //Fonction pour ajouter une occurrence d'un mot à l'index inverse, s'il est construit
+        void _ajouterIndexInverse(std::string_view motOriginal, std::string_view motTraduit);
+        //Fonction pour retirer une occurrence d'un mot de l'index inverse, s'il est construit
+        void _retirerIndexInverse(std::string_view motOriginal, std::string_view motTraduit);
+        //Fonction commune aux versions de ajouteMot; MotOriginal est std::string, const std::string & ou std::string_view
+        template<typename MotOriginal>
+        void _ajouter(MotOriginal &&motOriginal, std::string &&motTraduit);
+        //Fonction qui ajoute un mot et toutes ses traductions en les déplaçant, pour recharge
+        void _ajouterTraductions(std::string &&motOriginal, std::vector<std::string> &&traductions);
+        //Fonction appelée par ajouteMotEnPlace
+        void _ajouterEnPlace(std::string_view motOriginal, std::string &&motTraduit);
         //Fonction pour detruire un dico
         void _detruire(NoeudDictionnaire *&p_root);
 
         //Verifie si un mot est deja dans le dico
-        NoeudDictionnaire *_appartient(NoeudDictionnaire * const &p_root, const std::string &mot) const;
+        NoeudDictionnaire *_appartient(NoeudDictionnaire * const &p_root, std::string_view mot) const;
+
+        //Cherche un mot dans la table chaude puis dans l'arbre, et compte l'accès au besoin
+        NoeudDictionnaire *_chercher(std::string_view mot) const;
+        //Fonction pour échanger le contenu (mot, traductions, accès) de deux noeuds, en tenant la table chaude à jour
+        void _echangerContenu(NoeudDictionnaire *p_noeud1, NoeudDictionnaire *p_noeud2);
+        //Fonction pour ramasser les noeuds consultés au moins une fois
+        void _noeudsConsultes(NoeudDictionnaire *p_root, std::vector<std::pair<unsigned long, NoeudDictionnaire *>> &p_noeuds) const;
+        //Fonction pour remettre à zéro les accès d'un sous-arbre
+        void _reinitialiserAcces(NoeudDictionnaire *p_root);
 
         //Met la hauteur de l'arbre a jour.
         void _majHauteur(NoeudDictionnaire *&p_root);
@@ -147,6 +416,13 @@ namespace TP3 {
         //Retourne la hauteur d'un noeud
         int _hauteur(NoeudDictionnaire * &p_root) const;
 
+        //Retourne le nombre de noeuds d'un sous-arbre
+        std::size_t _taille(NoeudDictionnaire *p_root) const;
+        //Fonction qui compte les mots plus petits (ou égaux, si inclus) que le mot donné
+        std::size_t _rang(NoeudDictionnaire *p_root, std::string_view mot, bool inclus) const;
+        //Fonction récursive pour ajouter à la liste, en ordre, les nbMots mots à partir du rang debut
+        void _lister(NoeudDictionnaire *p_root, std::size_t debut, std::size_t nbMots, std::vector<std::string> &p_mots) const;
+
         //Tous les zigzig et zigzag pour faire les rotations
         void _zigZigGauche(NoeudDictionnaire * &p_noeudCritique);
         void _zigZagGauche(NoeudDictionnaire * &p_noeudCritique);
@@ -164,21 +440,87 @@ namespace TP3 {
         bool _debalancementADroite(NoeudDictionnaire * &p_root) const;
         bool _sousArbrePencheAGauche(NoeudDictionnaire * &p_root) const;
         bool _sousArbrePencheADroite(NoeudDictionnaire * &p_root) const;
-        //Fonction recursive pour ajouter mot
-        void _insererAVL(NoeudDictionnaire * &p_root, const std::string &motOriginal, const std::string &motTraduit);
-        //Fonction recursive pour ajouter une traduction
-        NoeudDictionnaire *& _trouverMot(NoeudDictionnaire *&p_root, const std::string &mot) const;
+        //Fonction recursive pour ajouter mot; retourne le nouveau noeud
+        NoeudDictionnaire *_insererAVL(NoeudDictionnaire * &p_root, std::string &&motOriginal, std::string &&motTraduit);
+        //Fonction qui retire un mot de l'arbre et des structures annexes
+        void _retirerMot(const std::string &motASupprimer, NoeudDictionnaire *noeudMot);
+        //Fonction qui retire une traduction d'un mot, et le mot s'il n'a plus de traduction
+        void _retirerTraduction(const std::string &motASupprimer, NoeudDictionnaire *noeudMot,
+                                std::vector<std::string>::iterator traduction);
+        //Fonction qui remplace toutes les traductions d'un mot, en tenant l'index inverse et la trace à jour
+        void _remplacerTraductions(const std::string &mot, NoeudDictionnaire *noeudMot, std::vector<std::string> &&traductions,
+                                   std::size_t &p_ajoutees, std::size_t &p_retirees);
         //Fonction recursive pour supprimer un mot
-        void _supprimerAVL(NoeudDictionnaire * &p_root, const std::string &motASupprimer);
+        void _supprimerAVL(NoeudDictionnaire * &p_root, std::string_view motASupprimer);
         //Fonction pour verifier si noeud a 2 fils
         bool _aDeuxfils(NoeudDictionnaire * &p_root) const;
         //Fonction qui retourne le plus petit noeud d'un arbre
         NoeudDictionnaire * _min(NoeudDictionnaire *p_root) const;
         //Fonction pour trouver distance entre 2 mots  en utilisant l'algorithm de Levenshtein (edit distance)
-        unsigned int _getEditDistance(const std::string &first, const std::string &second) const;
+        //Caractere est char pour des mots ASCII, char32_t pour des points de code
+        template<typename Caractere>
+        unsigned int _getEditDistance(const Caractere *first, std::size_t len1, const Caractere *second, std::size_t len2) const;
+        //Fonction qui calcule la similitude de deux suites de caractères
+        template<typename Caractere>
+        double _similitude(const Caractere *mot1, std::size_t longueur1, const Caractere *mot2, std::size_t longueur2) const;
+        //Fonction qui vérifie si un mot ne contient que des caractères ASCII, 8 octets à la fois
+        bool _estAscii(std::string_view mot) const;
+        //Fonction qui décode un mot UTF-8 en points de code; un octet invalide compte pour un caractère
+        void _decoderUtf8(std::string_view mot, std::vector<char32_t> &points) const;
+        //Fonction qui retire les espaces ASCII au début et à la fin d'une chaîne
+        void _rogner(std::string &chaine) const;
         //Fonction pour parcourir le dictionnaire en PreOrdre
         void _parcousSuggestion(NoeudDictionnaire *p_root, std::vector<std::pair <double,
-                std::string>> &p_vectPair, std::string p_motMalEcrit) const;
+                std::string_view>> &p_vectPair, std::string_view p_motMalEcrit) const;
+        //Fonction qui trie les mots similaires et garde les meilleures suggestions
+        std::vector<std::string> _choisirSuggestions(std::vector<std::pair <double, std::string_view>> &p_comparaison) const;
+        //Fonction récursive qui accumule le profil d'un sous-arbre
+        void _profiler(NoeudDictionnaire *p_root, int p_profondeur, ProfilArbre &p_profil,
+                       std::size_t &p_sommeProfondeurs, unsigned long long &p_sommeComparaisons,
+                       unsigned long long &p_sommeComparaisonsArbre) const;
+        //Fonction qui retourne la mémoire allouée par une chaîne en dehors de l'objet lui-même
+        std::size_t _octetsChaine(const std::string &chaine) const;
+        //Fonctions de jonction et de séparation d'arbres AVL
+        //Joint deux arbres dont tous les mots de p_gauche précèdent p_milieu, qui précède tous ceux de p_droite
+        NoeudDictionnaire *_joindre(NoeudDictionnaire *p_gauche, NoeudDictionnaire *p_milieu, NoeudDictionnaire *p_droite);
+        //Joint deux arbres sans noeud du milieu
+        NoeudDictionnaire *_joindreSansMilieu(NoeudDictionnaire *p_gauche, NoeudDictionnaire *p_droite);
+        //Retire le plus grand noeud d'un arbre et retourne le reste
+        NoeudDictionnaire *_separerDernier(NoeudDictionnaire *p_root, NoeudDictionnaire *&p_dernier);
+        //Sépare un arbre en mots plus petits, le noeud du mot (ou 0) et mots plus grands
+        void _separer(NoeudDictionnaire *p_root, std::string_view mot, NoeudDictionnaire *&p_gauche,
+                      NoeudDictionnaire *&p_trouve, NoeudDictionnaire *&p_droite);
+        //Union, différence et intersection récursives; p_arbre2 est une copie dont on dispose
+        //_unir liste les noeuds ajoutés; _retrancher détache les noeuds retirés sans les libérer
+        NoeudDictionnaire *_unir(NoeudDictionnaire *p_arbre1, NoeudDictionnaire *p_arbre2, int p_niveauxParalleles,
+                                 std::vector<NoeudDictionnaire *> &p_ajoutes);
+        NoeudDictionnaire *_retrancher(NoeudDictionnaire *p_arbre1, NoeudDictionnaire *p_arbre2, int p_niveauxParalleles,
+                                       std::vector<NoeudDictionnaire *> &p_retires);
+        NoeudDictionnaire *_intersecter(NoeudDictionnaire *p_arbre1, NoeudDictionnaire *p_arbre2, int p_niveauxParalleles);
+        //Ajoute à p_destination les traductions de p_source qu'il n'a pas déjà
+        void _fusionnerTraductions(NoeudDictionnaire *p_destination, const NoeudDictionnaire *p_source);
+        //Retourne une copie d'un sous-arbre
+        NoeudDictionnaire *_copier(const NoeudDictionnaire *p_root) const;
+        //Nombre de niveaux de récursion à paralléliser selon nbThreadsEnBloc ou le nombre de coeurs
+        int _niveauxParalleles() const;
+        //Ajoute une opération à la trace, si elle est enregistrée; le verrou doit être pris
+        void _enregistrer(OperationTrace operation, std::string_view mot,
+                          std::string_view traduction = std::string_view()) const;
+        //Reconstruit le filtre de Bloom avec les dimensions données à partir des mots de l'arbre
+        void _reconstruireFiltre(std::size_t capacite, double tauxFauxPositifs);
+        //Ajoute au filtre les mots d'un sous-arbre
+        void _remplirFiltre(const NoeudDictionnaire *p_root);
+        //Ajoute à une liste tous les noeuds d'un sous-arbre
+        void _listerNoeuds(NoeudDictionnaire *p_root, std::vector<NoeudDictionnaire *> &p_noeuds) const;
+        //Remet à jour le compteur et les structures annexes après une opération en bloc
+        void _apresOperationEnBloc(bool p_reconstruireFiltre);
+        //Fonction pour comparer le dictionnaire (en ordre) au contenu d'un nouveau fichier
+        void _parcoursDifferences(std::map<std::string, std::vector<std::string>> &p_nouveau,
+                                  std::vector<std::string> &p_motsSupprimes,
+                                  std::vector<std::pair<std::string, std::vector<std::string>>> &p_remplacements) const;
     };
+
+    //Affiche un résumé du profil de l'arbre
+    std::ostream &operator<<(std::ostream &out, const Dictionnaire::ProfilArbre &profil);
 }
 #endif /* DICO_H_ */
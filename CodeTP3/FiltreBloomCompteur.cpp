@@ -0,0 +1,206 @@
+/**
+ * \file FiltreBloomCompteur.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe FiltreBloomCompteur
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#include "FiltreBloomCompteur.h"
+
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+// Nombre de compteurs par bloc, et valeur d'un compteur saturé
+#define COMPTEURS_PAR_BLOC 128
+#define COMPTEUR_MAX 15u
+// Nombre maximal de compteurs par mot
+#define HACHAGES_MAX 16
+
+namespace TP3 {
+    /**
+     * \brief Constructeur
+     * \param[in] capacite le nombre de mots prevu
+     * \param[in] tauxFauxPositifs le taux de faux positifs vise lorsque le filtre contient capacite mots
+     * \post Le filtre est vide
+     */
+    FiltreBloomCompteur::FiltreBloomCompteur(std::size_t capacite, double tauxFauxPositifs) :
+            capaciteVisee(capacite), tauxFauxPositifsVise(tauxFauxPositifs), elements(0) {
+        if (capacite == 0) {
+            throw std::logic_error("FiltreBloomCompteur: la capacite doit etre positive.");
+        }
+        if (!(tauxFauxPositifs > 0.0 && tauxFauxPositifs < 1.0)) {
+            throw std::logic_error("FiltreBloomCompteur: le taux de faux positifs doit etre entre 0 et 1.");
+        }
+        //Dimensions optimales d'un filtre de Bloom ordinaire: m = -n ln(p) / ln(2)^2 compteurs et k = -log2(p) hachages
+        double nbCompteurs = -static_cast<double>(capacite) * std::log(tauxFauxPositifs) / (std::log(2.0) * std::log(2.0));
+        std::size_t nbBlocs = static_cast<std::size_t>(std::ceil(nbCompteurs / COMPTEURS_PAR_BLOC));
+        if (nbBlocs == 0) {
+            nbBlocs = 1;
+        }
+        long k = std::lround(-std::log2(tauxFauxPositifs));
+        hachages = static_cast<unsigned int>(k < 1 ? 1 : (k > HACHAGES_MAX ? HACHAGES_MAX : k));
+        //Les blocs ne recoivent pas tous le meme nombre de mots, ce qui augmente le taux: on ajoute des blocs
+        //jusqu'a atteindre le taux vise
+        while (_tauxModele(static_cast<double>(capacite) / nbBlocs) > tauxFauxPositifs) {
+            nbBlocs += nbBlocs / 16 + 1;
+        }
+        blocs.assign(nbBlocs, Bloc());
+    }
+
+    /**
+     * \brief Ajoute un mot
+     * \param[in] mot le mot a ajouter
+     * \post contientPeutEtre(mot) retourne true
+     */
+    void FiltreBloomCompteur::ajoute(std::string_view mot) {
+        Positions p = _positions(mot);
+        Bloc &bloc = blocs[p.bloc];
+        for (unsigned int i = 0; i < hachages; i++) {
+            unsigned int position = p.position[i];
+            unsigned int decalage = (position % 16) * 4;
+            std::uint64_t &mot64 = bloc.mots[position / 16];
+            if (((mot64 >> decalage) & 0xF) < COMPTEUR_MAX) {
+                mot64 += std::uint64_t(1) << decalage;
+            }
+        }
+        elements++;
+    }
+
+    /**
+     * \brief Retire un mot
+     * \param[in] mot le mot a retirer
+     * \pre Le mot a ete ajoute et n'a pas encore ete retire
+     */
+    void FiltreBloomCompteur::retire(std::string_view mot) {
+        Positions p = _positions(mot);
+        Bloc &bloc = blocs[p.bloc];
+        for (unsigned int i = 0; i < hachages; i++) {
+            unsigned int position = p.position[i];
+            unsigned int decalage = (position % 16) * 4;
+            std::uint64_t &mot64 = bloc.mots[position / 16];
+            std::uint64_t valeur = (mot64 >> decalage) & 0xF;
+            //Un compteur saturé a peut-etre compte plus de mots qu'il ne peut en representer
+            if (valeur > 0 && valeur < COMPTEUR_MAX) {
+                mot64 -= std::uint64_t(1) << decalage;
+            }
+        }
+        if (elements > 0) {
+            elements--;
+        }
+    }
+
+    /**
+     * \brief Verifie si un mot peut avoir ete ajoute
+     * \param[in] mot le mot a verifier
+     * \return false si le mot n'a certainement pas ete ajoute
+     */
+    bool FiltreBloomCompteur::contientPeutEtre(std::string_view mot) const {
+        Positions p = _positions(mot);
+        const Bloc &bloc = blocs[p.bloc];
+        for (unsigned int i = 0; i < hachages; i++) {
+            unsigned int position = p.position[i];
+            if (((bloc.mots[position / 16] >> ((position % 16) * 4)) & 0xF) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * \brief Retire tous les mots
+     * \post Le filtre est vide et garde ses dimensions
+     */
+    void FiltreBloomCompteur::vide() {
+        blocs.assign(blocs.size(), Bloc());
+        elements = 0;
+    }
+
+    /**
+     * \brief Retourne la memoire occupee par les compteurs
+     * \return le nombre d'octets des blocs
+     */
+    std::size_t FiltreBloomCompteur::octets() const {
+        return blocs.size() * sizeof(Bloc);
+    }
+
+    /**
+     * \brief Estime le taux de faux positifs actuel
+     *        Un mot absent est un faux positif si ses k compteurs sont non nuls: avec une proportion f
+     *        de compteurs non nuls dans son bloc, le taux est pres de f^k. On fait la moyenne sur les blocs.
+     * \return le taux estime, entre 0 et 1
+     */
+    double FiltreBloomCompteur::tauxFauxPositifsEstime() const {
+        double somme = 0.0;
+        for (const Bloc &bloc : blocs) {
+            unsigned int nonNuls = 0;
+            for (std::uint64_t mot64 : bloc.mots) {
+                for (unsigned int decalage = 0; decalage < 64; decalage += 4) {
+                    if (((mot64 >> decalage) & 0xF) != 0) {
+                        nonNuls++;
+                    }
+                }
+            }
+            somme += std::pow(static_cast<double>(nonNuls) / COMPTEURS_PAR_BLOC, hachages);
+        }
+        return somme / blocs.size();
+    }
+
+    /**
+     * \brief Calcule le taux de faux positifs prevu pour un nombre moyen de mots par bloc
+     *        Le nombre de mots d'un bloc suit une loi de Poisson; un bloc de j mots a une proportion
+     *        1 - (1 - 1/128)^(kj) de compteurs non nuls.
+     * \param[in] motsParBloc le nombre moyen de mots par bloc
+     * \return le taux prevu, entre 0 et 1
+     */
+    double FiltreBloomCompteur::_tauxModele(double motsParBloc) const {
+        double vide = std::pow(1.0 - 1.0 / COMPTEURS_PAR_BLOC, hachages);
+        double probabilite = std::exp(-motsParBloc);
+        double taux = 0.0;
+        std::size_t dernier = static_cast<std::size_t>(motsParBloc + 10.0 * std::sqrt(motsParBloc) + 20.0);
+        for (std::size_t j = 0; j <= dernier; j++) {
+            taux += probabilite * std::pow(1.0 - std::pow(vide, static_cast<double>(j)), hachages);
+            probabilite *= motsParBloc / (j + 1);
+        }
+        return taux;
+    }
+
+    /**
+     * \brief Calcule l'emplacement d'un mot
+     *        Un hachage de 64 bits choisit le bloc; chaque position est une tranche de 7 bits d'un second
+     *        hachage, melange a nouveau au besoin. Des positions independantes donnent un taux plus pres du
+     *        modele que le double hachage, qui n'a que peu de combinaisons possibles dans 128 compteurs.
+     * \param[in] mot le mot
+     * \return le bloc et les positions du mot
+     */
+    FiltreBloomCompteur::Positions FiltreBloomCompteur::_positions(std::string_view mot) const {
+        std::uint64_t h1 = std::hash<std::string_view>()(mot);
+        Positions p;
+        p.bloc = static_cast<std::size_t>(h1 % blocs.size());
+        std::uint64_t bits = h1;
+        for (unsigned int i = 0; i < hachages; i++) {
+            //Une valeur melangee fournit 9 tranches de 7 bits
+            if (i % 9 == 0) {
+                bits = _melanger(h1 + i);
+            }
+            p.position[i] = static_cast<std::uint8_t>(bits % COMPTEURS_PAR_BLOC);
+            bits >>= 7;
+        }
+        return p;
+    }
+
+    /**
+     * \brief Melange les bits d'une valeur (fonction de finalisation de splitmix64)
+     * \param[in] valeur la valeur a melanger
+     * \return la valeur melangee
+     */
+    std::uint64_t FiltreBloomCompteur::_melanger(std::uint64_t valeur) {
+        valeur += 0x9E3779B97F4A7C15ull;
+        valeur = (valeur ^ (valeur >> 30)) * 0xBF58476D1CE4E5B9ull;
+        valeur = (valeur ^ (valeur >> 27)) * 0x94D049BB133111EBull;
+        return valeur ^ (valeur >> 31);
+    }
+
+}//Fin du namespace
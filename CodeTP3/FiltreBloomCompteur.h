@@ -0,0 +1,85 @@
+/**
+ * \file FiltreBloomCompteur.h
+ * \brief Ce fichier contient l'interface d'un filtre de Bloom à compteurs, qui écarte les mots absents du dictionnaire.
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#ifndef FILTREBLOOMCOMPTEUR_H_
+#define FILTREBLOOMCOMPTEUR_H_
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace TP3 {
+
+//classe représentant un filtre de Bloom à compteurs de 4 bits, découpé en blocs d'une ligne de cache
+//Toutes les positions d'un mot tombent dans le même bloc de 64 octets: une vérification ne coûte qu'un
+//accès mémoire. Un « non » est certain; un « peut-être » est faux avec une probabilité près du taux visé.
+//Les compteurs permettent de retirer un mot. Un compteur saturé (15) n'est plus jamais décrémenté,
+//pour ne jamais produire de faux négatif.
+//Le filtre n'est pas protégé: c'est au dictionnaire de le modifier sous son verrou d'écriture.
+    class FiltreBloomCompteur {
+    public:
+
+        //Constructeur. Le filtre est dimensionné pour capacite mots au taux de faux positifs donné.
+        //Exception	logic_error si la capacité est nulle ou si le taux n'est pas entre 0 et 1 exclusivement
+        explicit FiltreBloomCompteur(std::size_t capacite = 4096, double tauxFauxPositifs = 0.01);
+
+        //Ajouter un mot au filtre
+        void ajoute(std::string_view mot);
+
+        //Retirer un mot qui a été ajouté
+        void retire(std::string_view mot);
+
+        //Retourne false si le mot n'a certainement pas été ajouté
+        bool contientPeutEtre(std::string_view mot) const;
+
+        //Retirer tous les mots, sans changer les dimensions du filtre
+        void vide();
+
+        //Accesseurs
+        std::size_t capacite() const { return capaciteVisee; }
+        double tauxVise() const { return tauxFauxPositifsVise; }
+        std::size_t nbElements() const { return elements; }
+        unsigned int nbHachages() const { return hachages; }
+
+        //Mémoire occupée par les compteurs, en octets
+        std::size_t octets() const;
+
+        //Estimer le taux de faux positifs actuel à partir de la proportion de compteurs non nuls
+        //Parcourt tous les compteurs: à ne pas appeler à chaque recherche.
+        double tauxFauxPositifsEstime() const;
+
+    private:
+
+        // Un bloc d'une ligne de cache: 8 mots de 64 bits, soit 128 compteurs de 4 bits
+        struct alignas(64) Bloc {
+            std::uint64_t mots[8];
+        };
+
+        // Emplacement d'un mot dans le filtre: son bloc et ses positions dans le bloc (au plus 16)
+        struct Positions {
+            std::size_t bloc;
+            std::uint8_t position[16];
+        };
+
+        std::vector<Bloc> blocs;
+        std::size_t capaciteVisee;
+        double tauxFauxPositifsVise;
+        std::size_t elements;       // Nombre de mots ajoutés moins le nombre de mots retirés
+        unsigned int hachages;      // Nombre de compteurs par mot
+
+        //Calcule le bloc et les positions d'un mot
+        Positions _positions(std::string_view mot) const;
+        //Calcule le taux de faux positifs prévu selon le nombre moyen de mots par bloc
+        double _tauxModele(double motsParBloc) const;
+        //Mélange les bits d'un hachage
+        static std::uint64_t _melanger(std::uint64_t valeur);
+    };
+}
+
+#endif /* FILTREBLOOMCOMPTEUR_H_ */
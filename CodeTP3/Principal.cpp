@@ -9,7 +9,6 @@
 
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include "Dictionnaire.h"
 #include "algorithm"
 
@@ -52,30 +51,33 @@ int main()
 	    // Affichage du dictionnaire niveau par niveau
 	    cout << dictEnFr << endl;
 
-		vector<string> motsAnglais; //Vecteur qui contiendra les mots anglais de la phrase entrée
+		vector<string_view> motsAnglais; //Vecteur qui contiendra les mots anglais de la phrase entrée (vues sur reponse)
 
 		//Lecture de la phrase en anglais
 		cout << "Entrez un texte en anglais (pas de majuscules ou de ponctuation/caracteres speciaux):" << endl;
 		getline(cin, reponse);
 
-		stringstream reponse_ss(reponse);
-		string str_temp;
-
 		//On ajoute un mot au vecteur de mots tant qu'on en trouve dans la phrase (séparateur = espace)
-		while (reponse_ss >> str_temp)
+		//Les mots sont des vues sur la phrase: aucune copie n'est faite
+		const char *separateurs = " \t\r\n";
+		for (size_t debut = reponse.find_first_not_of(separateurs); debut != string::npos;)
 		{
-			motsAnglais.push_back(str_temp);
+			size_t fin = reponse.find_first_of(separateurs, debut);
+			if (fin == string::npos)
+				fin = reponse.size();
+			motsAnglais.push_back(string_view(reponse).substr(debut, fin - debut));
+			debut = reponse.find_first_not_of(separateurs, fin);
 		}
 
 		vector<string> motsFrancais; //Vecteur qui contiendra les mots traduits en français
 
-		for (vector<string>::const_iterator i = motsAnglais.begin(); i != motsAnglais.end(); i++)
+		for (vector<string_view>::const_iterator i = motsAnglais.begin(); i != motsAnglais.end(); i++)
 			// Itération dans les mots anglais de la phrase donnée
 		{
 
             if (dictEnFr.appartient(*i))
             {
-                vector<string> traduction = dictEnFr.traduit(*i);
+                span<const string> traduction = dictEnFr.traduit(*i);
                 if (traduction.size() > 1){
                     cout << "Plusieurs traductions sont possibles pour le mot '" << *i << "'. Veuillez en choisir une parmi les suivantes :" << endl;
                     for (int i = 0; i < traduction.size(); i++){
@@ -106,7 +108,7 @@ int main()
                     cin >> index;
                     string motCorrigeAnglais = suggestion[index - 1];
 
-                    vector<string> traduction = dictEnFr.traduit(motCorrigeAnglais);
+                    span<const string> traduction = dictEnFr.traduit(motCorrigeAnglais);
                     if (traduction.size() > 1){
                         cout << "Plusieurs traductions sont possibles pour le mot '" << motCorrigeAnglais << "'. Veuillez en choisir une parmi les suivantes :" << endl;
                         for (int i = 0; i < traduction.size(); i++){
@@ -129,14 +131,15 @@ int main()
             }
 		}
 
-		stringstream phraseFrancais; // On crée un string contenant la phrase,
+		string phraseFrancais; // On crée un string contenant la phrase,
 									 // À partir du vecteur de mots traduits.
 		for (vector<string>::const_iterator i = motsFrancais.begin(); i != motsFrancais.end(); i++)
 		{
-			phraseFrancais << *i << " ";
+			phraseFrancais += *i;
+			phraseFrancais += ' ';
 		}
 
-		cout << "La phrase en francais est :" << endl << phraseFrancais.str() << endl;
+		cout << "La phrase en francais est :" << endl << phraseFrancais << endl;
 
 	}
 	catch (exception & e)
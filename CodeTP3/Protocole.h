@@ -0,0 +1,79 @@
+/**
+ * \file Protocole.h
+ * \brief Ce fichier contient le protocole binaire du serveur de traduction local.
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Requête : identifiant (u32), opération (u8), longueur du mot (u16), puis le mot.
+ * Réponse : identifiant (u32), statut (u8), nombre de mots (u16), puis pour chaque mot sa longueur (u16) et le mot.
+ * Les entiers sont dans l'ordre natif de la machine, puisque le client et le serveur s'y trouvent tous les deux.
+ * Un client peut envoyer plusieurs requêtes sans attendre: les réponses portent l'identifiant de leur requête
+ * et peuvent arriver dans le désordre.
+ */
+
+#ifndef PROTOCOLE_H_
+#define PROTOCOLE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace TP3 {
+    namespace Protocole {
+
+        //Chemin du socket utilisé si aucun n'est donné
+        const char *const CHEMIN_DEFAUT = "/tmp/dictionnaire.sock";
+
+        //Opérations offertes par le serveur
+        enum Operation : std::uint8_t {
+            APPARTIENT = 1,
+            TRADUIT = 2,
+            SUGGERE = 3
+        };
+
+        //Statut d'une réponse
+        enum Statut : std::uint8_t {
+            OK = 0,         // La requête a réussi
+            ABSENT = 1,     // Le mot n'appartient pas au dictionnaire
+            ERREUR = 2      // Opération inconnue ou erreur du dictionnaire
+        };
+
+        const std::size_t TAILLE_ENTETE_REQUETE = 7;   // identifiant, opération, longueur
+        const std::size_t TAILLE_ENTETE_REPONSE = 7;   // identifiant, statut, nombre de mots
+        const std::size_t LONGUEUR_MAX = 0xFFFF;        // Longueur maximale d'un mot transmis
+
+        //Ajoute un entier de 16 bits à la fin d'un tampon
+        inline void ecrireU16(std::string &tampon, std::uint16_t valeur) {
+            tampon.append(reinterpret_cast<const char *>(&valeur), sizeof(valeur));
+        }
+
+        //Ajoute un entier de 32 bits à la fin d'un tampon
+        inline void ecrireU32(std::string &tampon, std::uint32_t valeur) {
+            tampon.append(reinterpret_cast<const char *>(&valeur), sizeof(valeur));
+        }
+
+        //Ajoute un mot précédé de sa longueur; un mot trop long est tronqué
+        inline void ecrireMot(std::string &tampon, const std::string &mot) {
+            std::size_t longueur = mot.size() < LONGUEUR_MAX ? mot.size() : LONGUEUR_MAX;
+            ecrireU16(tampon, static_cast<std::uint16_t>(longueur));
+            tampon.append(mot, 0, longueur);
+        }
+
+        //Lit un entier de 16 bits à l'adresse donnée
+        inline std::uint16_t lireU16(const char *donnees) {
+            std::uint16_t valeur;
+            std::memcpy(&valeur, donnees, sizeof(valeur));
+            return valeur;
+        }
+
+        //Lit un entier de 32 bits à l'adresse donnée
+        inline std::uint32_t lireU32(const char *donnees) {
+            std::uint32_t valeur;
+            std::memcpy(&valeur, donnees, sizeof(valeur));
+            return valeur;
+        }
+    }
+}
+
+#endif /* PROTOCOLE_H_ */
@@ -0,0 +1,192 @@
+/**
+ * \file Rejoue.cpp
+ * \brief Rejoue une trace d'opérations sur un dictionnaire et mesure le débit et les latences
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : Rejoue fichierDictionnaire fichierTrace [nbThreads] [facteurVitesse]
+ * Les entrées de la trace sont réparties à tour de rôle entre les threads, qui les exécutent dans leur ordre.
+ * facteurVitesse : 0 pour rejouer aussi vite que possible (défaut), 1 pour respecter les instants
+ * enregistrés, 2 pour aller deux fois plus vite, etc.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "Dictionnaire.h"
+#include "Trace.h"
+
+using namespace std;
+using namespace TP3;
+
+//Mesures d'un thread, par sorte d'opération
+struct Mesures
+{
+	vector<double> latencesUs[NB_OPERATIONS_TRACE];
+	size_t erreurs[NB_OPERATIONS_TRACE] = {};
+	double retardMaxUs = 0.0;   // Plus grand retard sur l'instant prévu, en vitesse enregistrée
+	size_t controle = 0;        // Somme des résultats, pour que les appels ne soient pas éliminés
+};
+
+//Retourne le centile p (entre 0 et 1) d'un vecteur trié
+static double centile(const vector<double> &valeurs, double p)
+{
+	size_t indice = static_cast<size_t>(p * (valeurs.size() - 1) + 0.5);
+	return valeurs[indice];
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		cerr << "Utilisation : " << argv[0] << " fichierDictionnaire fichierTrace [nbThreads] [facteurVitesse]" << endl;
+		return 1;
+	}
+	size_t nbThreads = argc > 3 ? strtoul(argv[3], 0, 10) : 1;
+	double facteurVitesse = argc > 4 ? strtod(argv[4], 0) : 0.0;
+	if (nbThreads == 0) nbThreads = 1;
+
+	try
+	{
+		ifstream englishFrench(argv[1]);
+		if (!englishFrench)
+		{
+			cerr << "Fichier '" << argv[1] << "' introuvable!" << endl;
+			return 1;
+		}
+		Dictionnaire dictEnFr(englishFrench);
+		englishFrench.close();
+
+		ifstream fichierTrace(argv[2], ios::binary);
+		if (!fichierTrace)
+		{
+			cerr << "Fichier '" << argv[2] << "' introuvable!" << endl;
+			return 1;
+		}
+		vector<EntreeTrace> entrees = lisTrace(fichierTrace);
+		if (entrees.empty())
+		{
+			cerr << "La trace est vide." << endl;
+			return 1;
+		}
+
+		vector<Mesures> mesures(nbThreads);
+		vector<thread> threads;
+		chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+
+		for (size_t t = 0; t < nbThreads; t++)
+		{
+			threads.emplace_back([&, t]()
+			{
+				Mesures &m = mesures[t];
+				for (size_t i = t; i < entrees.size(); i += nbThreads)
+				{
+					const EntreeTrace &entree = entrees[i];
+					if (facteurVitesse > 0.0)
+					{
+						chrono::steady_clock::time_point prevu = debut + chrono::duration_cast<chrono::steady_clock::duration>(
+								chrono::duration<double, nano>(entree.instantNs / facteurVitesse));
+						this_thread::sleep_until(prevu);
+						double retard = chrono::duration<double, micro>(chrono::steady_clock::now() - prevu).count();
+						m.retardMaxUs = max(m.retardMaxUs, retard);
+					}
+
+					chrono::steady_clock::time_point avant = chrono::steady_clock::now();
+					try
+					{
+						switch (entree.operation)
+						{
+							case TRACE_APPARTIENT:
+								m.controle += dictEnFr.appartient(entree.mot);
+								break;
+							case TRACE_TRADUIT:
+								m.controle += dictEnFr.traduitCopie(entree.mot).size();
+								break;
+							case TRACE_SUGGERE:
+								m.controle += dictEnFr.suggereCorrections(entree.mot).size();
+								break;
+							case TRACE_AJOUTE:
+								dictEnFr.ajouteMot(entree.mot, entree.traduction);
+								break;
+							case TRACE_SUPPRIME:
+								dictEnFr.supprimeMot(entree.mot);
+								break;
+							case TRACE_SUPPRIME_TRADUCTION:
+								dictEnFr.supprimeTraduction(entree.mot, entree.traduction);
+								break;
+						}
+					}
+					catch (logic_error &)
+					{
+						//Par exemple un mot supprimé deux fois, ou dans un autre ordre qu'à l'enregistrement
+						m.erreurs[entree.operation]++;
+					}
+					m.latencesUs[entree.operation].push_back(
+							chrono::duration<double, micro>(chrono::steady_clock::now() - avant).count());
+				}
+			});
+		}
+		for (thread &t : threads)
+		{
+			t.join();
+		}
+		double secondes = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+		//Regroupe les mesures des threads
+		size_t controle = 0;
+		double retardMaxUs = 0.0;
+		for (const Mesures &m : mesures)
+		{
+			controle += m.controle;
+			retardMaxUs = max(retardMaxUs, m.retardMaxUs);
+		}
+
+		cout << entrees.size() << " operations, " << nbThreads << " threads, vitesse ";
+		if (facteurVitesse > 0.0)
+			cout << facteurVitesse << "x" << endl;
+		else
+			cout << "maximale" << endl;
+		cout << secondes << " s, " << entrees.size() / secondes << " operations/s (controle " << controle << ")" << endl;
+		if (facteurVitesse > 0.0)
+		{
+			cout << "Retard maximal sur la trace : " << retardMaxUs << " us" << endl;
+		}
+		cout << endl << left << setw(20) << "operation" << right << setw(10) << "nombre" << setw(9) << "erreurs"
+			 << setw(10) << "p50 us" << setw(10) << "p90 us" << setw(10) << "p99 us" << setw(11) << "p99.9 us"
+			 << setw(11) << "max us" << endl;
+		cout << fixed << setprecision(2);
+		for (size_t op = TRACE_APPARTIENT; op < NB_OPERATIONS_TRACE; op++)
+		{
+			vector<double> latences;
+			size_t erreurs = 0;
+			for (const Mesures &m : mesures)
+			{
+				latences.insert(latences.end(), m.latencesUs[op].begin(), m.latencesUs[op].end());
+				erreurs += m.erreurs[op];
+			}
+			if (latences.empty())
+			{
+				continue;
+			}
+			sort(latences.begin(), latences.end());
+			cout << left << setw(20) << nomOperationTrace(static_cast<OperationTrace>(op)) << right
+				 << setw(10) << latences.size() << setw(9) << erreurs
+				 << setw(10) << centile(latences, 0.50) << setw(10) << centile(latences, 0.90)
+				 << setw(10) << centile(latences, 0.99) << setw(11) << centile(latences, 0.999)
+				 << setw(11) << latences.back() << endl;
+		}
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * \file Serveur.cpp
+ * \brief Démon qui charge le dictionnaire une seule fois et le sert sur un socket Unix
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : Serveur fichierDictionnaire [cheminSocket] [nbTravailleurs] [fichierTrace]
+ * Si fichierTrace est donné, les requêtes servies y sont enregistrées pour être rejouées avec Rejoue.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <csignal>
+#include <cstdlib>
+#include <memory>
+#include <pthread.h>
+#include "Dictionnaire.h"
+#include "ServeurDictionnaire.h"
+
+using namespace std;
+using namespace TP3;
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		cerr << "Utilisation : " << argv[0] << " fichierDictionnaire [cheminSocket] [nbTravailleurs] [fichierTrace]" << endl;
+		return 1;
+	}
+
+	try
+	{
+		string chemin = argc > 2 ? argv[2] : Protocole::CHEMIN_DEFAUT;
+		size_t nbTravailleurs = argc > 3 ? strtoul(argv[3], 0, 10) : 4;
+
+		ifstream englishFrench(argv[1]);
+		if (!englishFrench)
+		{
+			cerr << "Fichier '" << argv[1] << "' introuvable!" << endl;
+			return 1;
+		}
+		Dictionnaire dictEnFr(englishFrench);
+		englishFrench.close();
+
+		unique_ptr<EnregistreurTrace> trace;
+		if (argc > 4)
+		{
+			trace.reset(new EnregistreurTrace(argv[4]));
+			dictEnFr.enregistreTrace(trace.get());
+		}
+
+		//Les signaux d'arrêt sont bloqués dans tous les threads, puis attendus ici
+		sigset_t signaux;
+		sigemptyset(&signaux);
+		sigaddset(&signaux, SIGINT);
+		sigaddset(&signaux, SIGTERM);
+		pthread_sigmask(SIG_BLOCK, &signaux, 0);
+
+		ServeurDictionnaire serveur(dictEnFr, chemin, nbTravailleurs);
+		serveur.demarre();
+		cout << "Dictionnaire servi sur '" << chemin << "'." << endl;
+
+		int signal;
+		sigwait(&signaux, &signal);
+		serveur.arrete();
+
+		ServeurDictionnaire::Statistiques stats = serveur.statistiques();
+		cout << stats.requetes << " requetes en " << stats.lots << " lots, "
+			 << stats.connexions << " connexions." << endl;
+		if (trace)
+		{
+			dictEnFr.enregistreTrace(nullptr);
+			trace->vide();
+			cout << trace->nbEntrees() << " operations enregistrees dans '" << argv[4] << "'." << endl;
+		}
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,430 @@
+/**
+ * \file ServeurDictionnaire.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe ServeurDictionnaire
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#include "ServeurDictionnaire.h"
+
+#include <cerrno>
+#include <map>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Taille du tampon de lecture d'une connexion
+#define TAILLE_TAMPON_LECTURE 65536
+
+// Au-delà de ce nombre de requêtes sans réponse ou de ce nombre d'octets de réponses pas encore lues par le client,
+// le lecteur d'une connexion cesse de lire ses requêtes jusqu'à ce que le client rattrape son retard
+#define MAX_EN_COURS_CONNEXION 4096
+#define LIMITE_SORTIE_CONNEXION (1 << 20)
+
+namespace TP3 {
+    /**
+     * \brief Constructeur
+     * \param[in] dictionnaire le dictionnaire a partager
+     * \param[in] chemin le chemin du socket Unix
+     * \param[in] nbTravailleurs le nombre de threads de traitement
+     * \param[in] tailleLot le nombre maximal de requetes traitees d'un coup par un travailleur
+     * \post Le serveur est pret a etre demarre
+     */
+    ServeurDictionnaire::ServeurDictionnaire(Dictionnaire &dictionnaire, const std::string &chemin,
+                                             std::size_t nbTravailleurs, std::size_t tailleLot) :
+            dictionnaire(dictionnaire), chemin(chemin),
+            nbTravailleurs(nbTravailleurs == 0 ? 1 : nbTravailleurs), tailleLot(tailleLot == 0 ? 1 : tailleLot),
+            fdEcoute(-1), arret(false), nbRequetes(0), nbLots(0), nbLecteurs(0), nbConnexions(0) {}
+
+    /**
+     *  \brief Destructeur
+     *  \post Le serveur est arrete
+     */
+    ServeurDictionnaire::~ServeurDictionnaire() {
+        arrete();
+    }
+
+    /**
+     * \brief Ouvre le socket et lance les threads du serveur
+     * \post Le serveur accepte les connexions
+     */
+    void ServeurDictionnaire::demarre() {
+        if (fdEcoute != -1) {
+            throw std::logic_error("demarre: le serveur est deja en marche.");
+        }
+
+        sockaddr_un adresse = {};
+        adresse.sun_family = AF_UNIX;
+        if (chemin.size() >= sizeof(adresse.sun_path)) {
+            throw std::runtime_error("demarre: le chemin du socket est trop long.");
+        }
+        std::strcpy(adresse.sun_path, chemin.c_str());
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd == -1) {
+            throw std::runtime_error("demarre: impossible de creer le socket.");
+        }
+        //Un socket laisse par une execution precedente empecherait le bind. On ne le retire que si personne n'y
+        //repond: sinon on volerait le chemin d'un serveur en marche.
+        struct stat etat;
+        if (lstat(chemin.c_str(), &etat) == 0 && S_ISSOCK(etat.st_mode)) {
+            int sonde = socket(AF_UNIX, SOCK_STREAM, 0);
+            int erreur = sonde == -1 || connect(sonde, reinterpret_cast<sockaddr *>(&adresse), sizeof(adresse)) == -1
+                         ? errno : 0;
+            if (sonde != -1) {
+                close(sonde);
+            }
+            if (erreur != ECONNREFUSED) {
+                close(fd);
+                throw std::runtime_error("demarre: un serveur ecoute deja sur " + chemin + ".");
+            }
+            unlink(chemin.c_str());
+        }
+        if (bind(fd, reinterpret_cast<sockaddr *>(&adresse), sizeof(adresse)) == -1 || listen(fd, SOMAXCONN) == -1) {
+            close(fd);
+            throw std::runtime_error("demarre: impossible d'ecouter sur " + chemin + ".");
+        }
+
+        fdEcoute = fd;
+        arret = false;
+        for (std::size_t i = 0; i < nbTravailleurs; i++) {
+            travailleurs.emplace_back(&ServeurDictionnaire::_travailler, this);
+        }
+        accepteur = std::thread(&ServeurDictionnaire::_accepter, this);
+    }
+
+    /**
+     * \brief Arrete le serveur
+     * \post Les connexions sont fermees, les threads termines et le socket supprime
+     */
+    void ServeurDictionnaire::arrete() {
+        if (fdEcoute == -1) {
+            return;
+        }
+        arret = true;
+
+        //Debloque accept() puis attend le thread accepteur
+        shutdown(fdEcoute, SHUT_RDWR);
+        accepteur.join();
+        close(fdEcoute);
+        fdEcoute = -1;
+
+        //Debloque les lecteurs, qui se terminent d'eux-memes
+        {
+            std::unique_lock<std::mutex> verrou(verrouConnexions);
+            for (const std::weak_ptr<Connexion> &faible : connexions) {
+                std::shared_ptr<Connexion> connexion = faible.lock();
+                if (connexion) {
+                    shutdown(connexion->fd, SHUT_RDWR);
+                }
+            }
+            lecteursTermines.wait(verrou, [this] { return nbLecteurs == 0; });
+            connexions.clear();
+        }
+
+        {
+            std::lock_guard<std::mutex> verrou(verrouRequetes);
+            requetes.clear();
+        }
+        requetesDisponibles.notify_all();
+        for (std::thread &travailleur : travailleurs) {
+            travailleur.join();
+        }
+        travailleurs.clear();
+        unlink(chemin.c_str());
+    }
+
+    /**
+     * \brief Retourne les statistiques du serveur
+     * \return les nombres de requetes, de lots et de connexions depuis le demarrage
+     */
+    ServeurDictionnaire::Statistiques ServeurDictionnaire::statistiques() const {
+        Statistiques stats;
+        {
+            std::lock_guard<std::mutex> verrou(verrouRequetes);
+            stats.requetes = nbRequetes;
+            stats.lots = nbLots;
+        }
+        std::lock_guard<std::mutex> verrou(verrouConnexions);
+        stats.connexions = nbConnexions;
+        return stats;
+    }
+
+    /**
+     *  \brief Destructeur d'une connexion
+     *  \post Le socket du client est ferme
+     */
+    ServeurDictionnaire::Connexion::~Connexion() {
+        close(fdReveil);
+        close(fd);
+    }
+
+    /**
+     * \brief Ajoute des reponses a la sortie du client et en ecrit ce que le socket accepte sans bloquer
+     *        Le lecteur est reveille s'il reste des octets a ecrire ou s'il attendait que enCours diminue.
+     * \param[in] tampon les reponses a envoyer
+     * \param[in] nbReponses le nombre de reponses dans le tampon
+     */
+    void ServeurDictionnaire::Connexion::envoie(const std::string &tampon, std::size_t nbReponses) {
+        std::lock_guard<std::mutex> verrou(verrouSortie);
+        enCours -= nbReponses;
+        if (fermee) {
+            return;
+        }
+        sortie.append(tampon);
+        ecrisSortie();
+        if (lecteurEnAttente || !sortie.empty()) {
+            std::uint64_t un = 1;
+            ssize_t n = write(fdReveil, &un, sizeof(un));
+            (void) n;   //L'eventfd ne peut pas deborder: le lecteur le vide a chaque reveil
+        }
+    }
+
+    /**
+     * \brief Ecrit ce que le socket accepte de la sortie, sans bloquer
+     * \return false si le client a ferme la connexion
+     */
+    bool ServeurDictionnaire::Connexion::ecrisSortie() {
+        std::size_t envoye = 0;
+        while (envoye < sortie.size()) {
+            ssize_t n = send(fd, sortie.data() + envoye, sortie.size() - envoye, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n == -1 && errno == EINTR) {
+                continue;
+            }
+            if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            if (n <= 0) {
+                fermee = true;
+                sortie.clear();
+                return false;
+            }
+            envoye += n;
+        }
+        sortie.erase(0, envoye);
+        return true;
+    }
+
+    /**
+     * \brief Accepte les connexions et lance un lecteur pour chacune
+     */
+    void ServeurDictionnaire::_accepter() {
+        while (!arret) {
+            int fd = accept(fdEcoute, 0, 0);
+            if (fd == -1) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                return;
+            }
+
+            int fdReveil = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fdReveil == -1) {
+                close(fd);
+                continue;
+            }
+            std::shared_ptr<Connexion> connexion = std::make_shared<Connexion>(fd, fdReveil);
+            {
+                std::lock_guard<std::mutex> verrou(verrouConnexions);
+                //On en profite pour oublier les connexions fermees
+                connexions.erase(std::remove_if(connexions.begin(), connexions.end(),
+                                                [](const std::weak_ptr<Connexion> &c) { return c.expired(); }),
+                                 connexions.end());
+                connexions.push_back(connexion);
+                nbLecteurs++;
+                nbConnexions++;
+            }
+            std::thread(&ServeurDictionnaire::_lire, this, connexion).detach();
+        }
+    }
+
+    /**
+     * \brief Lit les requetes d'un client et les ajoute a la file commune, et ecrit les reponses en retard
+     *        Toutes les requetes completes recues d'un coup sont ajoutees ensemble. Tant que le client a trop
+     *        de requetes en cours ou de reponses non lues, on attend sans lire ses requetes.
+     * \param[in] p_connexion la connexion du client
+     */
+    void ServeurDictionnaire::_lire(std::shared_ptr<Connexion> p_connexion) {
+        std::string recu;
+        std::vector<char> tampon(TAILLE_TAMPON_LECTURE);
+        std::vector<Requete> nouvelles;
+
+        while (!arret) {
+            bool lire, ecrire;
+            {
+                std::lock_guard<std::mutex> verrou(p_connexion->verrouSortie);
+                ecrire = !p_connexion->sortie.empty();
+                lire = p_connexion->enCours < MAX_EN_COURS_CONNEXION &&
+                       p_connexion->sortie.size() < LIMITE_SORTIE_CONNEXION;
+                p_connexion->lecteurEnAttente = ecrire || !lire;
+            }
+            pollfd attente[2] = {{p_connexion->fd, static_cast<short>((lire ? POLLIN : 0) | (ecrire ? POLLOUT : 0)), 0},
+                                 {p_connexion->fdReveil, POLLIN, 0}};
+            if (poll(attente, 2, -1) == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if (attente[1].revents & POLLIN) {
+                std::uint64_t compte;
+                ssize_t n = read(p_connexion->fdReveil, &compte, sizeof(compte));
+                (void) n;
+            }
+            if ((attente[0].revents & (POLLERR | POLLNVAL)) ||
+                ((attente[0].revents & POLLHUP) && !(attente[0].revents & POLLIN))) {
+                break;
+            }
+            if (attente[0].revents & POLLOUT) {
+                std::lock_guard<std::mutex> verrou(p_connexion->verrouSortie);
+                if (!p_connexion->ecrisSortie()) {
+                    break;
+                }
+            }
+            if (!(attente[0].revents & POLLIN)) {
+                continue;
+            }
+
+            ssize_t n = recv(p_connexion->fd, tampon.data(), tampon.size(), MSG_DONTWAIT);
+            if (n == -1 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            recu.append(tampon.data(), n);
+
+            //Decoupe toutes les requetes completes du tampon
+            std::size_t position = 0;
+            while (recu.size() - position >= Protocole::TAILLE_ENTETE_REQUETE) {
+                const char *entete = recu.data() + position;
+                std::size_t longueur = Protocole::lireU16(entete + 5);
+                if (recu.size() - position < Protocole::TAILLE_ENTETE_REQUETE + longueur) {
+                    break;
+                }
+                Requete requete;
+                requete.connexion = p_connexion;
+                requete.identifiant = Protocole::lireU32(entete);
+                requete.operation = static_cast<std::uint8_t>(entete[4]);
+                requete.mot.assign(entete + Protocole::TAILLE_ENTETE_REQUETE, longueur);
+                nouvelles.push_back(std::move(requete));
+                position += Protocole::TAILLE_ENTETE_REQUETE + longueur;
+            }
+            recu.erase(0, position);
+
+            if (!nouvelles.empty()) {
+                {
+                    std::lock_guard<std::mutex> verrou(p_connexion->verrouSortie);
+                    p_connexion->enCours += nouvelles.size();
+                }
+                {
+                    std::lock_guard<std::mutex> verrou(verrouRequetes);
+                    for (Requete &requete : nouvelles) {
+                        requetes.push_back(std::move(requete));
+                    }
+                }
+                requetesDisponibles.notify_all();
+                nouvelles.clear();
+            }
+        }
+
+        //Les reponses encore en traitement seront jetees
+        {
+            std::lock_guard<std::mutex> verrou(p_connexion->verrouSortie);
+            p_connexion->fermee = true;
+            p_connexion->sortie.clear();
+        }
+        std::lock_guard<std::mutex> verrou(verrouConnexions);
+        nbLecteurs--;
+        lecteursTermines.notify_all();
+    }
+
+    /**
+     * \brief Traite les requetes de la file par lots
+     *        Les reponses d'un lot destinees a un meme client sont envoyees en une seule ecriture, qui ne bloque pas.
+     */
+    void ServeurDictionnaire::_travailler() {
+        std::vector<Requete> lot;
+        std::map<Connexion *, Reponses> reponses;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> verrou(verrouRequetes);
+                requetesDisponibles.wait(verrou, [this] { return arret || !requetes.empty(); });
+                if (requetes.empty()) {
+                    return;
+                }
+                while (!requetes.empty() && lot.size() < tailleLot) {
+                    lot.push_back(std::move(requetes.front()));
+                    requetes.pop_front();
+                }
+                nbRequetes += lot.size();
+                nbLots++;
+            }
+
+            for (const Requete &requete : lot) {
+                Reponses &destination = reponses[requete.connexion.get()];
+                if (!destination.connexion) {
+                    destination.connexion = requete.connexion;
+                    destination.nombre = 0;
+                }
+                _repondre(requete, destination.tampon);
+                destination.nombre++;
+            }
+            for (std::pair<Connexion *const, Reponses> &destination : reponses) {
+                destination.second.connexion->envoie(destination.second.tampon, destination.second.nombre);
+            }
+            reponses.clear();
+            lot.clear();
+        }
+    }
+
+    /**
+     * \brief Execute une requete sur le dictionnaire et encode sa reponse
+     * \param[in] p_requete la requete a traiter
+     * \param[in,out] p_tampon le tampon auquel ajouter la reponse
+     */
+    void ServeurDictionnaire::_repondre(const Requete &p_requete, std::string &p_tampon) {
+        Protocole::Statut statut = Protocole::OK;
+        std::vector<std::string> mots;
+        try {
+            switch (p_requete.operation) {
+                case Protocole::APPARTIENT:
+                    if (!dictionnaire.appartient(p_requete.mot)) {
+                        statut = Protocole::ABSENT;
+                    }
+                    break;
+                case Protocole::TRADUIT:
+                    mots = dictionnaire.traduitCopie(p_requete.mot);
+                    if (mots.empty()) {
+                        statut = Protocole::ABSENT;
+                    }
+                    break;
+                case Protocole::SUGGERE:
+                    mots = dictionnaire.suggereCorrections(p_requete.mot);
+                    break;
+                default:
+                    statut = Protocole::ERREUR;
+            }
+        }
+        catch (std::exception &) {
+            statut = Protocole::ERREUR;
+            mots.clear();
+        }
+
+        std::size_t nbMots = mots.size() < Protocole::LONGUEUR_MAX ? mots.size() : Protocole::LONGUEUR_MAX;
+        Protocole::ecrireU32(p_tampon, p_requete.identifiant);
+        p_tampon.push_back(static_cast<char>(statut));
+        Protocole::ecrireU16(p_tampon, static_cast<std::uint16_t>(nbMots));
+        for (std::size_t i = 0; i < nbMots; i++) {
+            Protocole::ecrireMot(p_tampon, mots[i]);
+        }
+    }
+
+}//Fin du namespace
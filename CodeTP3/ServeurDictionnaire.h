@@ -0,0 +1,138 @@
+/**
+ * \file ServeurDictionnaire.h
+ * \brief Ce fichier contient l'interface d'un serveur de traduction sur un socket Unix.
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#ifndef SERVEURDICTIONNAIRE_H_
+#define SERVEURDICTIONNAIRE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Dictionnaire.h"
+#include "Protocole.h"
+
+namespace TP3 {
+
+//classe représentant un serveur qui partage un dictionnaire chargé une seule fois entre plusieurs processus
+    class ServeurDictionnaire {
+    public:
+
+        //Statistiques de fonctionnement du serveur
+        struct Statistiques {
+            std::uint64_t requetes;     // Nombre de requêtes traitées
+            std::uint64_t lots;         // Nombre de lots traités par les travailleurs
+            std::uint64_t connexions;   // Nombre de connexions acceptées
+        };
+
+        //Constructeur
+        //Le dictionnaire doit exister tant que le serveur est en marche
+        //nbTravailleurs threads traitent les requêtes, regroupées par lots d'au plus tailleLot requêtes
+        ServeurDictionnaire(Dictionnaire &dictionnaire, const std::string &chemin,
+                            std::size_t nbTravailleurs = 4, std::size_t tailleLot = 64);
+
+        //Destructeur. Arrête le serveur s'il est en marche.
+        ~ServeurDictionnaire();
+
+        ServeurDictionnaire(const ServeurDictionnaire &) = delete;
+        ServeurDictionnaire &operator=(const ServeurDictionnaire &) = delete;
+
+        //Ouvrir le socket et commencer à servir les requêtes
+        //Exception	logic_error si le serveur est déjà en marche
+        //Exception	runtime_error si le socket ne peut pas être ouvert
+        void demarre();
+
+        //Fermer toutes les connexions et arrêter les threads. Sans effet si le serveur est arrêté.
+        void arrete();
+
+        //Retourne les statistiques depuis le démarrage
+        Statistiques statistiques() const;
+
+    private:
+
+        // Classe interne représentant la connexion d'un client
+        // Les écritures ne bloquent jamais: ce que le socket n'accepte pas reste dans la sortie, que le lecteur
+        // de la connexion écrit quand le client lit. Un client qui ne lit pas ses réponses ne retient donc
+        // aucun travailleur; le lecteur cesse plutôt de lire ses requêtes.
+        class Connexion {
+        public:
+            int fd;                     // Le descripteur du socket du client
+            int fdReveil;               // Un eventfd qui réveille le lecteur lorsque la sortie ou enCours change
+            std::mutex verrouSortie;    // Protège les champs suivants
+            std::string sortie;         // Les réponses que le socket n'a pas encore acceptées
+            std::size_t enCours;        // Nombre de requêtes lues et pas encore répondues
+            bool lecteurEnAttente;      // Le lecteur attend de pouvoir écrire la sortie ou de reprendre la lecture
+            bool fermee;                // Le client est parti: les réponses sont jetées
+
+            Connexion(int p_fd, int p_fdReveil) :
+                    fd(p_fd), fdReveil(p_fdReveil), enCours(0), lecteurEnAttente(false), fermee(false) {}
+            ~Connexion();
+
+            //Ajoute les réponses de nbReponses requêtes à la sortie et en écrit ce que le socket accepte sans bloquer
+            void envoie(const std::string &tampon, std::size_t nbReponses);
+
+            //Écrit ce que le socket accepte de la sortie, sans bloquer; verrouSortie doit être pris
+            //Retourne false si le client est parti.
+            bool ecrisSortie();
+        };
+
+        // Classe interne représentant les réponses d'un lot destinées à une même connexion
+        class Reponses {
+        public:
+            std::shared_ptr<Connexion> connexion;
+            std::string tampon;         // Les réponses encodées
+            std::size_t nombre;         // Le nombre de réponses dans le tampon
+        };
+
+        // Classe interne représentant une requête en attente de traitement
+        class Requete {
+        public:
+            std::shared_ptr<Connexion> connexion;   // La connexion à qui répondre
+            std::uint32_t identifiant;              // L'identifiant choisi par le client
+            std::uint8_t operation;                 // Une Protocole::Operation
+            std::string mot;                        // Le mot de la requête
+        };
+
+        Dictionnaire &dictionnaire;     // Le dictionnaire partagé
+        std::string chemin;             // Le chemin du socket Unix
+        std::size_t nbTravailleurs;     // Nombre de threads de traitement
+        std::size_t tailleLot;          // Nombre maximal de requêtes par lot
+
+        int fdEcoute;                   // Le socket d'écoute, -1 si le serveur est arrêté
+        std::atomic<bool> arret;        // Demande d'arrêt des threads
+        std::thread accepteur;          // Le thread qui accepte les connexions
+        std::vector<std::thread> travailleurs;
+
+        std::deque<Requete> requetes;   // Requêtes reçues de toutes les connexions
+        mutable std::mutex verrouRequetes;
+        std::condition_variable requetesDisponibles;
+        std::uint64_t nbRequetes, nbLots;
+
+        std::vector<std::weak_ptr<Connexion>> connexions;  // Pour fermer les connexions à l'arrêt
+        std::size_t nbLecteurs;         // Nombre de threads de lecture encore actifs
+        std::uint64_t nbConnexions;
+        mutable std::mutex verrouConnexions;
+        std::condition_variable lecteursTermines;
+
+        //Fonction du thread qui accepte les connexions
+        void _accepter();
+        //Fonction du thread qui lit les requêtes d'une connexion
+        void _lire(std::shared_ptr<Connexion> p_connexion);
+        //Fonction d'un thread qui traite les requêtes par lots
+        void _travailler();
+        //Fonction qui répond à une requête en ajoutant la réponse au tampon donné
+        void _repondre(const Requete &p_requete, std::string &p_tampon);
+    };
+}
+
+#endif /* SERVEURDICTIONNAIRE_H_ */
@@ -0,0 +1,267 @@
+/**
+ * \file TestOrdre.cpp
+ * \brief Vérifie rang, selectionne, compte et page en les comparant à un std::set
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : TestOrdre [nbOperations] [graine]
+ * Des mots courts au hasard sont ajoutés et supprimés, pour produire beaucoup de doublons et de rotations.
+ * Régulièrement, toutes les requêtes d'ordre sont comparées au résultat attendu d'un std::set, puis de même
+ * après une séparation et une fusion, qui recalculent les tailles des sous-arbres autrement.
+ * Enfin, recharge doit donner les mêmes traductions, dans le même ordre, qu'un dictionnaire construit à partir du
+ * nouveau fichier, même quand seul l'ordre des traductions d'un mot change. Un fichier temporaire TestOrdre.tmp est créé
+ * dans le répertoire courant pour cette vérification.
+ * Le programme retourne 1 à la première différence trouvée.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Dictionnaire.h"
+
+using namespace std;
+using namespace TP3;
+
+//Retourne un mot de 1 à 4 lettres parmi a à f
+static string motAuHasard(mt19937 &generateur)
+{
+	string mot;
+	size_t longueur = 1 + generateur() % 4;
+	for (size_t i = 0; i < longueur; i++)
+	{
+		mot += static_cast<char>('a' + generateur() % 6);
+	}
+	return mot;
+}
+
+//Compare toutes les requêtes d'ordre du dictionnaire à celles du std::set; retourne false à la première différence
+static bool verifie(const Dictionnaire &dictionnaire, const set<string> &reference, mt19937 &generateur)
+{
+	vector<string> mots(reference.begin(), reference.end());
+
+	for (size_t k = 0; k < mots.size(); k++)
+	{
+		if (dictionnaire.selectionne(k) != mots[k])
+		{
+			cerr << "selectionne(" << k << ") retourne '" << dictionnaire.selectionne(k) << "' au lieu de '"
+				 << mots[k] << "'" << endl;
+			return false;
+		}
+	}
+	try
+	{
+		dictionnaire.selectionne(mots.size());
+		cerr << "selectionne(" << mots.size() << ") aurait du lever out_of_range" << endl;
+		return false;
+	}
+	catch (out_of_range &)
+	{
+	}
+
+	for (int i = 0; i < 30; i++)
+	{
+		string motMin = motAuHasard(generateur), motMax = motAuHasard(generateur);
+		size_t rangAttendu = lower_bound(mots.begin(), mots.end(), motMin) - mots.begin();
+		if (dictionnaire.rang(motMin) != rangAttendu)
+		{
+			cerr << "rang('" << motMin << "') retourne " << dictionnaire.rang(motMin) << " au lieu de "
+				 << rangAttendu << endl;
+			return false;
+		}
+		size_t compteAttendu = motMax < motMin ? 0 : (upper_bound(mots.begin(), mots.end(), motMax) -
+													  lower_bound(mots.begin(), mots.end(), motMin));
+		if (dictionnaire.compte(motMin, motMax) != compteAttendu)
+		{
+			cerr << "compte('" << motMin << "', '" << motMax << "') retourne " << dictionnaire.compte(motMin, motMax)
+				 << " au lieu de " << compteAttendu << endl;
+			return false;
+		}
+	}
+
+	for (size_t debut = 0; debut < mots.size() + 3; debut += 7)
+	{
+		vector<string> attendue(mots.begin() + min(debut, mots.size()), mots.begin() + min(debut + 11, mots.size()));
+		if (dictionnaire.page(debut, 11) != attendue)
+		{
+			cerr << "page(" << debut << ", 11) ne correspond pas" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+//Écrit un contenu de dictionnaire dans le fichier temporaire, les mots en ordre et leurs traductions dans l'ordre donné
+static void ecrisFichier(const char *chemin, const map<string, vector<string>> &contenu)
+{
+	ofstream fichier(chemin);
+	for (const pair<const string, vector<string>> &entree : contenu)
+	{
+		for (const string &traduction : entree.second)
+			fichier << entree.first << '\t' << traduction << '\n';
+	}
+}
+
+//Recharge une nouvelle version du fichier, où des traductions sont réordonnées, ajoutées ou retirées, et compare
+//le résultat à un dictionnaire construit directement; retourne false à la première différence
+static bool verifieRecharge(mt19937 &generateur)
+{
+	const char *cheminTemporaire = "TestOrdre.tmp";
+	const vector<string> traductions = {"un", "deux", "trois", "quatre", "cinq"};
+	map<string, vector<string>> ancien, nouveau;
+	for (int i = 0; i < 300; i++)
+	{
+		vector<string> &liste = ancien[motAuHasard(generateur)];
+		liste.push_back(traductions[generateur() % traductions.size()]);
+	}
+	for (const pair<const string, vector<string>> &entree : ancien)
+	{
+		vector<string> liste = entree.second;
+		switch (generateur() % 5)
+		{
+			case 0:
+				reverse(liste.begin(), liste.end());    // seul l'ordre change si le mot a plusieurs traductions
+				break;
+			case 1:
+				liste.insert(liste.begin(), traductions[generateur() % traductions.size()]);
+				break;
+			case 2:
+				liste.pop_back();    // le mot disparaît s'il n'avait qu'une traduction
+				break;
+			default:
+				break;
+		}
+		if (!liste.empty())
+			nouveau[entree.first] = liste;
+	}
+	for (int i = 0; i < 30; i++)
+	{
+		nouveau[motAuHasard(generateur) + "z"].push_back(traductions[generateur() % traductions.size()]);
+	}
+
+	ecrisFichier(cheminTemporaire, ancien);
+	ifstream fichierAncien(cheminTemporaire);
+	Dictionnaire recharge(fichierAncien);
+	fichierAncien.close();
+	ecrisFichier(cheminTemporaire, nouveau);
+	ifstream fichierNouveau(cheminTemporaire);
+	recharge.recharge(fichierNouveau);
+	fichierNouveau.close();
+	ifstream fichierReference(cheminTemporaire);
+	Dictionnaire reference(fichierReference);
+	fichierReference.close();
+	remove(cheminTemporaire);
+
+	if (recharge.profil().nbNoeuds != reference.profil().nbNoeuds)
+	{
+		cerr << "recharge donne " << recharge.profil().nbNoeuds << " mots au lieu de " << reference.profil().nbNoeuds
+			 << endl;
+		return false;
+	}
+	for (const map<string, vector<string>> *contenu : {&ancien, &nouveau})
+	{
+		for (const pair<const string, vector<string>> &entree : *contenu)
+		{
+			if (recharge.traduitCopie(entree.first) != reference.traduitCopie(entree.first))
+			{
+				cerr << "Apres recharge, les traductions de '" << entree.first
+					 << "' different de celles d'un dictionnaire construit du meme fichier" << endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t nbOperations = argc > 1 ? strtoul(argv[1], 0, 10) : 20000;
+	unsigned long graine = argc > 2 ? strtoul(argv[2], 0, 10) : 1;
+
+	try
+	{
+		mt19937 generateur(graine);
+		Dictionnaire dictionnaire;
+		set<string> reference;
+
+		for (size_t i = 0; i < nbOperations; i++)
+		{
+			string mot = motAuHasard(generateur);
+			if (generateur() % 3 == 0 && reference.count(mot))
+			{
+				//Une fois sur deux, le mot disparaît avec sa dernière traduction
+				if (generateur() % 2 == 0)
+					dictionnaire.supprimeMot(mot);
+				else
+					dictionnaire.supprimeTraduction(mot, "t");
+				reference.erase(mot);
+			}
+			else if (!reference.count(mot))
+			{
+				dictionnaire.ajouteMot(mot, "t");
+				reference.insert(mot);
+			}
+			if (i % 97 == 0 && !verifie(dictionnaire, reference, generateur))
+			{
+				cerr << "Difference apres " << i + 1 << " operations (graine " << graine << ")" << endl;
+				return 1;
+			}
+		}
+		if (!verifie(dictionnaire, reference, generateur))
+		{
+			cerr << "Difference a la fin (graine " << graine << ")" << endl;
+			return 1;
+		}
+
+		//Les jonctions des opérations en bloc doivent aussi tenir les tailles à jour
+		Dictionnaire superieurs;
+		string pivot = motAuHasard(generateur);
+		dictionnaire.separe(pivot, superieurs);
+		set<string> referenceInferieurs(reference.begin(), reference.lower_bound(pivot));
+		set<string> referenceSuperieurs(reference.lower_bound(pivot), reference.end());
+		if (!verifie(dictionnaire, referenceInferieurs, generateur) ||
+			!verifie(superieurs, referenceSuperieurs, generateur))
+		{
+			cerr << "Difference apres separe('" << pivot << "') (graine " << graine << ")" << endl;
+			return 1;
+		}
+		dictionnaire.fusionne(superieurs);
+		if (!verifie(dictionnaire, reference, generateur))
+		{
+			cerr << "Difference apres fusionne (graine " << graine << ")" << endl;
+			return 1;
+		}
+
+		Dictionnaire::ProfilArbre profil = dictionnaire.profil();
+		if (!profil.equilibres.empty() &&
+			(profil.equilibres.begin()->first < -1 || profil.equilibres.rbegin()->first > 1))
+		{
+			cerr << "L'arbre n'est plus equilibre" << endl;
+			return 1;
+		}
+		for (int essai = 0; essai < 10; essai++)
+		{
+			if (!verifieRecharge(generateur))
+			{
+				cerr << "Difference apres recharge (graine " << graine << ")" << endl;
+				return 1;
+			}
+		}
+		cout << nbOperations << " operations, " << reference.size() << " mots: ok" << endl;
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
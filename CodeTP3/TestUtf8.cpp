@@ -0,0 +1,137 @@
+/**
+ * \file TestUtf8.cpp
+ * \brief Vérifie la similitude et la lecture du fichier sur des mots UTF-8
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Utilisation : TestUtf8 [nbPairesAscii] [graine]
+ * Les mots accentués, les caractères de plusieurs octets et les octets invalides doivent compter pour un caractère
+ * chacun. Des paires de mots ASCII au hasard sont aussi comparées à une distance de Levenshtein calculée octet par
+ * octet, que le chemin rapide doit reproduire exactement.
+ * Un fichier temporaire TestUtf8.tmp est créé dans le répertoire courant pour vérifier la lecture.
+ * Le programme retourne 1 à la première différence trouvée.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "Dictionnaire.h"
+
+using namespace std;
+using namespace TP3;
+
+//Distance de Levenshtein octet par octet, par la table complète
+static size_t distanceOctets(const string &a, const string &b)
+{
+	vector<vector<size_t>> d(a.size() + 1, vector<size_t>(b.size() + 1));
+	for (size_t i = 0; i <= a.size(); i++)
+		d[i][0] = i;
+	for (size_t j = 0; j <= b.size(); j++)
+		d[0][j] = j;
+	for (size_t i = 1; i <= a.size(); i++)
+	{
+		for (size_t j = 1; j <= b.size(); j++)
+		{
+			d[i][j] = min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] != b[j - 1])});
+		}
+	}
+	return d[a.size()][b.size()];
+}
+
+//Compare une similitude à la valeur attendue; retourne false et affiche la paire si elles diffèrent
+static bool verifieSimilitude(const Dictionnaire &dictionnaire, const string &a, const string &b, double attendue)
+{
+	double obtenue = dictionnaire.similitude(a, b);
+	if (fabs(obtenue - attendue) > 1e-9)
+	{
+		cerr << "similitude('" << a << "', '" << b << "') retourne " << obtenue << " au lieu de " << attendue << endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t nbPairesAscii = argc > 1 ? strtoul(argv[1], 0, 10) : 20000;
+	unsigned long graine = argc > 2 ? strtoul(argv[2], 0, 10) : 1;
+
+	try
+	{
+		Dictionnaire dictionnaire;
+
+		//Un caractère accentué, un idéogramme ou un emoji est une seule modification
+		bool ok = verifieSimilitude(dictionnaire, "prevoir", "prévoir", 6.0 / 7) &&
+				  verifieSimilitude(dictionnaire, "contempler", "contemplé", 0.8) &&
+				  verifieSimilitude(dictionnaire, "été", "ete", 1.0 / 3) &&
+				  verifieSimilitude(dictionnaire, "日本", "日本語", 2.0 / 3) &&
+				  verifieSimilitude(dictionnaire, "😀a", "😀b", 0.5) &&
+				  verifieSimilitude(dictionnaire, "", "", 1.0) &&
+				  verifieSimilitude(dictionnaire, "é", "", 0.0) &&
+				  verifieSimilitude(dictionnaire, "kitten", "sitting", 1 - 3.0 / 7);
+		//Chaque octet invalide compte pour un caractère, distinct de tout caractère valide
+		ok = ok && verifieSimilitude(dictionnaire, "a\xff", "a\xfe", 0.5) &&
+			 verifieSimilitude(dictionnaire, "a\xff", "a\xff", 1.0) &&
+			 verifieSimilitude(dictionnaire, "\xC3", "\xC3\xA9", 0.0) &&    // séquence tronquée
+			 verifieSimilitude(dictionnaire, "\xC0\xAF", "/", 0.0) &&       // forme trop longue de '/'
+			 verifieSimilitude(dictionnaire, "\xED\xA0\x80", "x", 0.0);     // demi-code d'indirection
+		if (!ok)
+			return 1;
+
+		//Sur des mots ASCII, le chemin rapide doit donner exactement la distance octet par octet
+		mt19937 generateur(graine);
+		for (size_t i = 0; i < nbPairesAscii; i++)
+		{
+			string a(generateur() % 20, 'a'), b(generateur() % 20, 'a');
+			for (char &c : a)
+				c = static_cast<char>('a' + generateur() % 4);
+			for (char &c : b)
+				c = static_cast<char>('a' + generateur() % 4);
+			double longueur = max(a.size(), b.size());
+			double attendue = longueur == 0 ? 1.0 : (longueur - distanceOctets(a, b)) / longueur;
+			if (!verifieSimilitude(dictionnaire, a, b, attendue))
+			{
+				cerr << "Difference sur la paire " << i + 1 << " (graine " << graine << ")" << endl;
+				return 1;
+			}
+		}
+
+		//Lecture: marque d'ordre des octets, fins de ligne CR LF, espaces autour des champs, lignes sans tabulation
+		const char *cheminTemporaire = "TestUtf8.tmp";
+		{
+			ofstream fichier(cheminTemporaire, ios::binary);
+			fichier << "\xEF\xBB\xBF" "hello\tbonjour \r\n#commentaire\n\nsanstabulation\n"
+					<< "  spaced \t  \xC3\xA9t\xC3\xA9  [Noun]\r\n\tmotvide\n";
+		}
+		ifstream fichier(cheminTemporaire);
+		Dictionnaire lu(fichier);
+		fichier.close();
+		remove(cheminTemporaire);
+		if (!lu.appartient("hello") || lu.traduitCopie("hello") != vector<string>{"bonjour"} ||
+			!lu.appartient("spaced") || lu.traduitCopie("spaced") != vector<string>{"été"} ||
+			lu.appartient("sanstabulation") || lu.appartient("") || lu.profil().nbNoeuds != 2)
+		{
+			cerr << "Le fichier n'est pas lu correctement" << endl;
+			return 1;
+		}
+		if (lu.suggereCorrections("helo").size() != 1)
+		{
+			cerr << "suggereCorrections('helo') devrait trouver hello" << endl;
+			return 1;
+		}
+		cout << nbPairesAscii << " paires ASCII et les cas UTF-8: ok" << endl;
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * \file Trace.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe EnregistreurTrace et du lecteur de traces
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ */
+
+#include "Trace.h"
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+// En-tête et version du format
+#define ENTETE_TRACE "TP3TRACE"
+#define VERSION_TRACE 1
+// Taille du tampon au-delà de laquelle les entrées sont écrites dans le fichier
+#define TAILLE_TAMPON_TRACE 65536
+
+namespace TP3 {
+
+    /**
+     * \brief Ajoute un entier variable (LEB128) a la fin d'un tampon
+     * \param[in,out] tampon le tampon
+     * \param[in] valeur l'entier
+     */
+    static void ecrireEntierVariable(std::string &tampon, std::uint64_t valeur) {
+        while (valeur >= 0x80) {
+            tampon.push_back(static_cast<char>((valeur & 0x7F) | 0x80));
+            valeur >>= 7;
+        }
+        tampon.push_back(static_cast<char>(valeur));
+    }
+
+    /**
+     * \brief Lit un entier variable (LEB128)
+     * \param[in,out] position la position de lecture, avancee apres l'entier
+     * \param[in] fin la fin des donnees
+     * \return l'entier lu
+     */
+    static std::uint64_t lireEntierVariable(const char *&position, const char *fin) {
+        std::uint64_t valeur = 0;
+        for (unsigned int decalage = 0; decalage < 64; decalage += 7) {
+            if (position == fin) {
+                throw std::runtime_error("lisTrace: la trace est tronquee.");
+            }
+            std::uint8_t octet = static_cast<std::uint8_t>(*position++);
+            valeur |= static_cast<std::uint64_t>(octet & 0x7F) << decalage;
+            if ((octet & 0x80) == 0) {
+                return valeur;
+            }
+        }
+        throw std::runtime_error("lisTrace: entier invalide dans la trace.");
+    }
+
+    /**
+     * \brief Lit une chaine precedee de sa longueur
+     * \param[in,out] position la position de lecture, avancee apres la chaine
+     * \param[in] fin la fin des donnees
+     * \param[out] chaine la chaine lue
+     */
+    static void lireChaine(const char *&position, const char *fin, std::string &chaine) {
+        std::uint64_t longueur = lireEntierVariable(position, fin);
+        if (longueur > static_cast<std::uint64_t>(fin - position)) {
+            throw std::runtime_error("lisTrace: la trace est tronquee.");
+        }
+        chaine.assign(position, longueur);
+        position += longueur;
+    }
+
+    /**
+     * \brief Retourne le nom d'une operation
+     * \param[in] operation l'operation
+     * \return son nom, ou "inconnue"
+     */
+    const char *nomOperationTrace(OperationTrace operation) {
+        switch (operation) {
+            case TRACE_APPARTIENT:
+                return "appartient";
+            case TRACE_TRADUIT:
+                return "traduit";
+            case TRACE_SUGGERE:
+                return "suggereCorrections";
+            case TRACE_AJOUTE:
+                return "ajouteMot";
+            case TRACE_SUPPRIME:
+                return "supprimeMot";
+            case TRACE_SUPPRIME_TRADUCTION:
+                return "supprimeTraduction";
+        }
+        return "inconnue";
+    }
+
+    /**
+     * \brief Constructeur
+     * \param[in] chemin le fichier de trace a creer
+     * \post L'en-tete est ecrit et l'enregistreur est pret
+     */
+    EnregistreurTrace::EnregistreurTrace(const std::string &chemin) :
+            fichier(chemin, std::ios::binary | std::ios::trunc), entrees(0) {
+        if (!fichier) {
+            throw std::runtime_error("EnregistreurTrace: impossible de creer '" + chemin + "'.");
+        }
+        tampon.append(ENTETE_TRACE);
+        tampon.push_back(static_cast<char>(VERSION_TRACE));
+        _ecrireTampon();
+    }
+
+    /**
+     *  \brief Destructeur
+     *  \post Toutes les entrees sont ecrites dans le fichier
+     */
+    EnregistreurTrace::~EnregistreurTrace() {
+        vide();
+    }
+
+    /**
+     * \brief Ajoute une operation a la trace
+     * \param[in] operation l'operation
+     * \param[in] mot son mot
+     * \param[in] traduction sa traduction, s'il y a lieu
+     */
+    void EnregistreurTrace::enregistre(OperationTrace operation, std::string_view mot, std::string_view traduction) {
+        std::lock_guard<std::mutex> verrouTrace(verrou);
+        //L'instant est pris sous le verrou: les delais entre entrees ne sont jamais negatifs
+        std::chrono::steady_clock::time_point maintenant = std::chrono::steady_clock::now();
+        if (entrees == 0) {
+            precedent = maintenant;
+        }
+        ecrireEntierVariable(tampon, std::chrono::duration_cast<std::chrono::nanoseconds>(maintenant - precedent).count());
+        precedent = maintenant;
+        tampon.push_back(static_cast<char>(operation));
+        ecrireEntierVariable(tampon, mot.size());
+        tampon.append(mot);
+        ecrireEntierVariable(tampon, traduction.size());
+        tampon.append(traduction);
+        entrees++;
+        if (tampon.size() >= TAILLE_TAMPON_TRACE) {
+            _ecrireTampon();
+        }
+    }
+
+    /**
+     * \brief Ecrit les entrees accumulees dans le fichier
+     */
+    void EnregistreurTrace::vide() {
+        std::lock_guard<std::mutex> verrouTrace(verrou);
+        _ecrireTampon();
+        fichier.flush();
+    }
+
+    /**
+     * \brief Retourne le nombre d'entrees enregistrees
+     * \return le nombre d'entrees depuis la creation
+     */
+    std::size_t EnregistreurTrace::nbEntrees() const {
+        std::lock_guard<std::mutex> verrouTrace(verrou);
+        return entrees;
+    }
+
+    /**
+     * \brief Ecrit le tampon dans le fichier et le vide
+     */
+    void EnregistreurTrace::_ecrireTampon() {
+        fichier.write(tampon.data(), tampon.size());
+        tampon.clear();
+    }
+
+    /**
+     * \brief Lit toutes les entrees d'une trace
+     * \param[in] flot le flot de la trace, ouvert en mode binaire
+     * \return les entrees, avec leur instant depuis le debut de l'enregistrement
+     */
+    std::vector<EntreeTrace> lisTrace(std::istream &flot) {
+        std::string donnees((std::istreambuf_iterator<char>(flot)), std::istreambuf_iterator<char>());
+        std::size_t tailleEntete = std::strlen(ENTETE_TRACE);
+        if (donnees.size() <= tailleEntete || donnees.compare(0, tailleEntete, ENTETE_TRACE) != 0) {
+            throw std::runtime_error("lisTrace: ce n'est pas une trace.");
+        }
+        if (static_cast<std::uint8_t>(donnees[tailleEntete]) != VERSION_TRACE) {
+            throw std::runtime_error("lisTrace: version de trace inconnue.");
+        }
+
+        std::vector<EntreeTrace> entrees;
+        const char *position = donnees.data() + tailleEntete + 1;
+        const char *fin = donnees.data() + donnees.size();
+        std::uint64_t instant = 0;
+        while (position != fin) {
+            EntreeTrace entree;
+            instant += lireEntierVariable(position, fin);
+            entree.instantNs = instant;
+            if (position == fin) {
+                throw std::runtime_error("lisTrace: la trace est tronquee.");
+            }
+            entree.operation = static_cast<OperationTrace>(*position++);
+            if (entree.operation < TRACE_APPARTIENT || entree.operation > TRACE_SUPPRIME_TRADUCTION) {
+                throw std::runtime_error("lisTrace: operation inconnue dans la trace.");
+            }
+            lireChaine(position, fin, entree.mot);
+            lireChaine(position, fin, entree.traduction);
+            entrees.push_back(std::move(entree));
+        }
+        return entrees;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,94 @@
+/**
+ * \file Trace.h
+ * \brief Ce fichier contient l'enregistreur et le lecteur de traces d'opérations sur le dictionnaire.
+ * \author IFT-2008, Guillaume Marseille
+ * \version 0.1
+ * \date avril 2022
+ *
+ * Format d'une trace : l'en-tête "TP3TRACE" suivi de la version (1 octet), puis une entrée par opération :
+ *   délai depuis l'entrée précédente en nanosecondes (entier variable), opération (1 octet),
+ *   mot et traduction (chacun : longueur en entier variable, puis les octets).
+ * Un entier variable (LEB128) est écrit 7 bits à la fois, les petits d'abord; le bit 0x80 indique une suite.
+ * Une trace ne dépend donc pas de l'ordre des octets de la machine.
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TP3 {
+
+    //Opérations enregistrées
+    enum OperationTrace : std::uint8_t {
+        TRACE_APPARTIENT = 1,
+        TRACE_TRADUIT = 2,
+        TRACE_SUGGERE = 3,
+        TRACE_AJOUTE = 4,
+        TRACE_SUPPRIME = 5,
+        TRACE_SUPPRIME_TRADUCTION = 6
+    };
+
+    //Nombre de sortes d'opérations, plus un pour indexer directement par OperationTrace
+    const std::size_t NB_OPERATIONS_TRACE = 7;
+
+    //Retourne le nom d'une opération, pour les rapports
+    const char *nomOperationTrace(OperationTrace operation);
+
+    //Une opération lue d'une trace
+    struct EntreeTrace {
+        std::uint64_t instantNs;    // Instant de l'appel, en nanosecondes depuis le début de l'enregistrement
+        OperationTrace operation;
+        std::string mot;
+        std::string traduction;     // Vide sauf pour TRACE_AJOUTE et TRACE_SUPPRIME_TRADUCTION
+    };
+
+//classe représentant un enregistreur de trace, partagé par tous les threads qui utilisent le dictionnaire
+//Les entrées sont accumulées en mémoire et écrites par blocs; l'ordre des entrées est celui des appels.
+    class EnregistreurTrace {
+    public:
+
+        //Constructeur. Crée (ou remplace) le fichier de trace.
+        //Exception	runtime_error si le fichier ne peut pas être ouvert
+        explicit EnregistreurTrace(const std::string &chemin);
+
+        //Destructeur. Écrit les entrées qui restent en mémoire.
+        ~EnregistreurTrace();
+
+        EnregistreurTrace(const EnregistreurTrace &) = delete;
+        EnregistreurTrace &operator=(const EnregistreurTrace &) = delete;
+
+        //Ajouter une opération à la trace, à l'instant présent
+        void enregistre(OperationTrace operation, std::string_view mot, std::string_view traduction = std::string_view());
+
+        //Écrire dans le fichier les entrées accumulées
+        void vide();
+
+        //Retourner le nombre d'entrées enregistrées
+        std::size_t nbEntrees() const;
+
+    private:
+
+        mutable std::mutex verrou;
+        std::ofstream fichier;
+        std::string tampon;                                 // Entrées pas encore écrites
+        std::chrono::steady_clock::time_point precedent;    // Instant de l'entrée précédente
+        std::size_t entrees;
+
+        //Écrire le tampon dans le fichier; le verrou doit être pris
+        void _ecrireTampon();
+    };
+
+    //Lire toutes les entrées d'une trace
+    //Exception	runtime_error si le flot n'est pas une trace valide
+    std::vector<EntreeTrace> lisTrace(std::istream &flot);
+}
+
+#endif /* TRACE_H_ */